@@ -8,6 +8,7 @@
 #include "Cluster.hh"
 #include "Prioridad.hh"
 #include "Proceso.hh"    
+#include "Identificadores.hh"
 
 /** @class Area_de_Espera
  *  @brief Hace referencia a la area de espera de los procesos.
@@ -37,16 +38,16 @@ class Area_de_Espera {
      * \post Se ha añadido una nueva prioridad identificado como <em>id_prioridad</em> a la 
      * area de espera del parametro implicito.
     */
-    void alta_prioridad(string id_prioridad);
+    void alta_prioridad(Id id_prioridad);
 
     /** @brief Modificadora que elimina una prioridad en una area de espera.
      * \pre Existe una prioridad identificada como el parametro <em>id_prioridad</em> en 
      * la area de espera del parametro implicito. En caso que exista, no puede tener procesos 
-     * pendientes en ella.
+     * pendientes en ella, ni por volcar en su entrada concurrente (ver volcar_entradas).
      * \post Se ha eliminado la prioridad identificada como <em>id_prioridad</em> a la area de
      *  espera del parametro implicito.
     */
-    void baja_prioridad(string id_prioridad);
+    void baja_prioridad(Id id_prioridad);
 
     /** @brief Modificadora que anade un proceso a una prioridad de la area de espera.
      * \pre Existe una prioridad con el identificador del parametro <em>id_prioridad</em>.
@@ -54,18 +55,114 @@ class Area_de_Espera {
      * \post Se ha anadido un proceso a una prioridad identificado como <em>id_prioridad</em>
      *  que pertenece a la area de espera del parametro implicito.
     */
-    void alta_proceso_espera(string id_prioridad, const Proceso &job);
+    void alta_proceso_espera(Id id_prioridad, const Proceso &job);
+
+    /** @brief Modificadora que anade un proceso a una prioridad de la area de espera
+     *  moviendolo, sin copiarlo.
+     * \pre Las mismas que la version con <em>const Proceso &</em>.
+     * \post Las mismas que la version con <em>const Proceso &</em>; <em>job</em> queda en un
+     *  estado valido pero no especificado.
+    */
+    void alta_proceso_espera(Id id_prioridad, Proceso &&job);
+
+    /** @brief Modificadora que anade un proceso a una prioridad desde cualquier hilo.
+     * \pre Existe una prioridad con el identificador del parametro <em>id_prioridad</em> y no
+     *  se da de alta ni de baja ninguna prioridad durante la llamada. Puede llamarla cualquier
+     *  hilo, concurrentemente con otras llamadas a esta operacion.
+     * \post El resultado indica si habia sitio en la entrada concurrente de la prioridad. Si lo
+     *  habia, <em>job</em> se ha movido a ella (ver Prioridad::alta_proceso_concurrente para el
+     *  orden de antiguedad). Se comprueba si es un proceso repetido al volcarlo a la prioridad
+     *  (volcar_entradas), que escribe entonces el error.
+    */
+    bool alta_proceso_concurrente(Id id_prioridad, Proceso &&job);
+
+    /** @brief Modificadora que vuelca las entradas concurrentes a sus prioridades.
+     * \pre Solo la llama el hilo que ejecuta los comandos.
+     * \post Se han anadido a cada prioridad, por orden de prioridad, los procesos publicados
+     *  en su entrada concurrente (Prioridad::volcar_entrada), actualizando los agregados, y se
+     *  ha escrito en el canal de salida "ERROR: El proceso ya existe en la prioridad" por cada
+     *  proceso repetido descartado, como habria hecho <em>ape</em>, por orden de prioridad y de
+     *  entrada. El programa principal la llama antes de cada comando que consulta o modifica
+     *  la area de espera, de manera que ocupado, existe_proceso, <em>ipri</em>, <em>iae</em>
+     *  y <em>bp</em> ven los procesos enviados por los productores hasta ese momento.
+    */
+    void volcar_entradas();
+
+    /** @brief Modificadora que vuelca las entradas concurrentes escribiendo en un canal.
+     * \pre Las mismas que volcar_entradas().
+     * \post Lo mismo que volcar_entradas(), escribiendo los errores en <em>os</em>.
+    */
+    void volcar_entradas(ostream &os);
 
     /** @brief Modificadora que envia n procesos (eligidos tienendo en cuenta el orden de 
-     * prioridad. En una prioridad, los más antiguos) de una area de espera a un cluster.
+     * prioridad, el orden alfabetico de su identificador. En una prioridad, los más antiguos)
+     * de una area de espera a un cluster.
      * Si no hay espacio, entonces el proceso es rechazado y devuelto a la area de espera original.
      * \pre n >= 0.
      * \post Se han enviado los n procesos de la area de espera del parametro implicito a 
      * los procesadores del cluster del parametro <em>c</em> y se ha actualizado en la area
      *  de espera el numero de procesos acceptados y rechazados en las prioridades correspondentes.
+     *  Cada proceso se extrae de su prioridad moviendolo (extraer_mas_antiguo) y solo vuelve a
+     *  ella si es rechazado. Antes de enviar ningun proceso se hace volcar_entradas(). Un
+     *  proceso que requiere más memoria que el hueco más grande de <em>c</em>
+     *  (max_espacio_cluster, O(1)) se rechaza sin intentar colocarlo; una prioridad
+     *  cuyo proceso pendiente más pequeno no cabe se rechaza entera sin extraer ningun proceso;
+     *  y en cuanto ningun proceso por probar puede caber (segun la menor clase de tamano
+     *  pendiente), el resto se cuenta como rechazado sin intentarlo. Los procesos rechazados
+     *  así conservan su orden: el resultado es el mismo que probarlos uno a uno. Compilado con
+     *  <em>-DPRO2_REFERENCIA</em> no se hace ninguno de estos atajos.
     */
     void enviar_procesos_cluster(int n, Cluster &c); 
 
+    /** @brief Modificadora que envia n procesos a un cluster escribiendo en un canal.
+     * \pre Las mismas que enviar_procesos_cluster(<em>n</em>, <em>c</em>).
+     * \post Lo mismo que enviar_procesos_cluster(<em>n</em>, <em>c</em>), escribiendo los
+     *  errores del volcado en <em>os</em>.
+    */
+    void enviar_procesos_cluster(int n, Cluster &c, ostream &os);
+
+    /** @brief Modificadora que envia n procesos a varios clusters.
+     * \pre n >= 0; <em>particiones</em> no está vacio y ningun otro hilo usa sus clusters
+     *  durante la llamada.
+     * \post Como enviar_procesos_cluster(<em>n</em>, <em>c</em>), extrayendo los procesos en
+     *  el mismo orden, pero cada uno se envia con Cluster::alta_proceso al cluster de
+     *  <em>particiones</em> con el hueco más grande (max_espacio_cluster; en caso de empate, el
+     *  de menor indice) y, si no cabe en ese, es rechazado y vuelve a su prioridad. Los atajos
+     *  usan el hueco más grande de todos los clusters. Es el envio del modo particionado del
+     *  Despachador, y simular_envio(<em>n</em>, <em>particiones</em>, ...) lo simula.
+    */
+    void enviar_procesos_cluster(int n, const vector<Cluster *> &particiones);
+
+    /** @brief Modificadora que envia n procesos a varios clusters escribiendo en un canal.
+     * \pre Las mismas que enviar_procesos_cluster(<em>n</em>, <em>particiones</em>).
+     * \post Lo mismo que enviar_procesos_cluster(<em>n</em>, <em>particiones</em>),
+     *  escribiendo los errores del volcado en <em>os</em>.
+    */
+    void enviar_procesos_cluster(int n, const vector<Cluster *> &particiones, ostream &os);
+
+    /** @brief Operacion que simula un envio de procesos a un cluster sin modificar nada.
+     * \pre n >= 0.
+     * \post <em>aceptados</em> y <em>rechazados</em> son los procesos que aceptaria y
+     *  rechazaria el cluster <em>c</em> si se hiciera enviar_procesos_cluster(n, c) ahora sin
+     *  procesos en las entradas concurrentes. Ni la area de espera del parametro implicito ni
+     *  <em>c</em> se modifican: el envio se hace sobre una instantanea de simulación de
+     *  <em>c</em> y una copia del orden de los procesos pendientes, que no incluye los procesos
+     *  aun no volcados.
+    */
+    void simular_envio(int n, const Cluster &c, int &aceptados, int &rechazados) const;
+
+    /** @brief Operacion que simula un envio de procesos a varios clusters sin modificar nada.
+     * \pre n >= 0; <em>particiones</em> no está vacio y ningun otro hilo modifica sus clusters
+     *  durante la llamada.
+     * \post Como la version con un solo cluster, pero simulando
+     *  enviar_procesos_cluster(<em>n</em>, <em>particiones</em>): cada proceso se envia al
+     *  cluster de <em>particiones</em> con el hueco más grande (en caso de empate, el de menor
+     *  indice) y se rechaza si no cabe en ese. Se usa una instantanea de simulación de cada
+     *  cluster.
+    */
+    void simular_envio(int n, const vector<const Cluster *> &particiones, int &aceptados,
+                       int &rechazados) const;
+
     // Consultoras
 
     /** @brief Consultora de existencia de una prioridad.
@@ -73,14 +170,23 @@ class Area_de_Espera {
      * \post El resultado indica si existe una prioridad de id_prioridad en la area de espera
      *  del parametro implicito.
     */
-    bool existe_prioridad(string id_prioridad) const;
+    bool existe_prioridad(Id id_prioridad) const;
+
+    /** @brief Consultora que indica si las entradas concurrentes están vacias.
+     * \pre Solo la llama el hilo que ejecuta los comandos.
+     * \post El resultado indica si ninguna prioridad tenia procesos por volcar en su entrada
+     *  concurrente cuando se ha consultado (Prioridad::entrada_vacia). Si es cierto,
+     *  volcar_entradas() no habria anadido ningun proceso ni escrito nada.
+    */
+    bool entradas_vacias() const;
 
      /** @brief Consultora que indica si una prioridad tiene procesos en espera.
      * \pre Existe una prioridad identificado como <em>id_prioridad</em> en la area de espera
      *  del parametro implicito.
      * \post El resultado indica si la prioridad <em>id_prioridad</em> tiene procesos pendientes.
+     *  Solo cuenta los procesos ya volcados de la entrada concurrente (volcar_entradas).
     */
-    bool ocupado(string id_prioridad) const;
+    bool ocupado(Id id_prioridad) const;
 
      /** @brief Consultora que indica si una prioridad tiene un proceso en concreto en espera.
      * \pre Existe una prioridad identificado como <em>id_prioridad</em>en la area de espera
@@ -88,7 +194,43 @@ class Area_de_Espera {
      * \post El resultado indica si la prioridad <em>id_prioridad</em> de la area de espera
      *  del parametro implicito tiene un proceso identificado como <em>id_proceso</em> en espera.
     */
-    bool existe_proceso(string id_prioridad, int id_proceso) const;
+    bool existe_proceso(Id id_prioridad, int id_proceso) const;
+
+    /** @brief Consultora del numero total de procesos pendientes.
+     * \pre <em>cierto</em>
+     * \post El resultado es el numero de procesos en espera en todas las prioridades de la
+     *  area de espera del parametro implicito. Coste O(1).
+    */
+    int total_pendientes() const;
+
+    /** @brief Consultora de la memoria total pendiente.
+     * \pre <em>cierto</em>
+     * \post El resultado es la suma de las memorias requeridas por los procesos en espera en
+     *  la area de espera del parametro implicito. Coste O(1).
+    */
+    long long memoria_pendiente() const;
+
+    /** @brief Consultora de los procesos pendientes de una clase de tamano.
+     * \pre 0 <= <em>k</em> < numero de bits de Tamano
+     * \post El resultado es el numero de procesos en espera con memoria requerida en
+     *  [2^<em>k</em>, 2^(<em>k</em>+1)). Coste O(1).
+    */
+    int pendientes_clase(int k) const;
+
+    /** @brief Consultora de la menor clase de tamano con procesos pendientes.
+     * \pre total_pendientes() > 0
+     * \post El resultado es la menor <em>k</em> con pendientes_clase(<em>k</em>) > 0; ningun
+     *  proceso en espera requiere menos de 2^<em>k</em> de memoria. Coste O(1).
+    */
+    int menor_clase_pendiente() const;
+
+    /** @brief Consultora de la memoria ocupada por las colas de la area de espera.
+     * \pre <em>cierto</em>
+     * \post El resultado es el numero de bytes reservados por las colas de procesos en espera
+     *  de todas las prioridades de la area de espera del parametro implicito, con sus indices
+     *  por tamano (Prioridad::memoria_cola). Es lo que escribe <em>imr</em>.
+    */
+    size_t memoria_colas() const;
 
     //Lectura y Escriptura
     
@@ -99,7 +241,13 @@ class Area_de_Espera {
      *  de antiguedad desde su ultima alta y el numero de procesos enviados al cluster, juntamente
      *  con el numero de procesos rechazado por el cluster.
     */
-    void imprimir_prioridad(string id_prioridad) const;
+    void imprimir_prioridad(Id id_prioridad) const;
+
+    /** @brief Operacion de escriptura en un canal.
+     * \pre Las mismas que imprimir_prioridad(<em>id_prioridad</em>).
+     * \post Se escribe en <em>os</em> lo mismo que imprimir_prioridad(<em>id_prioridad</em>) escribe en el canal de salida.
+    */
+    void imprimir_prioridad(Id id_prioridad, ostream &os) const;
 
     /** @brief Operacion de escriptura de la area de espera.
      * \pre <em>cierto</em>
@@ -110,9 +258,21 @@ class Area_de_Espera {
     */
     void imprimir_area_espera() const;
 
+    /** @brief Operacion de escriptura en un canal.
+     * \pre Las mismas que imprimir_area_espera().
+     * \post Se escribe en <em>os</em> lo mismo que imprimir_area_espera() escribe en el canal de salida.
+    */
+    void imprimir_area_espera(ostream &os) const;
+
 
     private:
 
+    /** @brief Agregados de todas las prioridades, actualizados en cada alta, envio y
+     *  devolución de un proceso: numero de pendientes, memoria pendiente y pendientes por
+     *  clase de tamano. */
+    int pendientes;
+    long long memoria;
+    int por_clase[8 * sizeof(Tamano)];
 };
 
 
@@ -0,0 +1,115 @@
+/** @file Banco_Pruebas.hh
+    @brief Especificación de la clase Banco_Pruebas.
+*/
+
+#ifndef BANCO_PRUEBAS_HH
+#define BANCO_PRUEBAS_HH
+
+#ifndef NO_DIAGRAM
+#include <string>
+#include <vector>
+#include <functional>
+#include <atomic>
+#include <iostream>
+using namespace std;
+#endif
+
+/** @class Banco_Pruebas
+    @brief Arnés de microbenchmarks de las operaciones básicas de los modulos. Cada medida
+    repite una operacion varias veces, con una preparación que no se cuenta, y anota la mediana
+    del tiempo por operacion, las reservas de memoria por operacion y los fallos de cache por
+    operacion (con perf_event_open si el sistema lo permite; si no, -1). Los resultados se
+    pueden guardar como fichero base y comparar con uno guardado antes.
+*/
+class Banco_Pruebas {
+
+    public:
+
+    //Constructoras
+
+    /** @brief Creadora con numero de repeticiones.
+     * \pre <em>repeticiones</em> > 0
+     * \post El resultado es un banco sin medidas que repite cada medida <em>repeticiones</em>
+     *  veces. Si el sistema lo permite, queda abierto el contador de fallos de cache.
+    */
+    Banco_Pruebas(int repeticiones);
+
+    /** @brief Destructora.
+     * \pre <em>cierto</em>
+     * \post Se ha cerrado el contador de fallos de cache.
+    */
+    ~Banco_Pruebas();
+
+    //Modificadoras
+
+    /** @brief Modificadora que mide una operacion.
+     * \pre <em>operaciones</em> > 0 es el numero de operaciones basicas que hace cada llamada a
+     *  <em>operacion</em>. <em>nombre</em> no coincide con el de ninguna medida anterior.
+     * \post En cada repetición se ha llamado a <em>preparar</em> y a continuación a
+     *  <em>operacion</em>, midiendo solo <em>operacion</em>: <em>preparar</em> se llama antes de
+     *  cada repetición, no solo de la primera, así que debe dejar el estado que
+     *  <em>operacion</em> necesita aunque la repetición anterior lo haya consumido. Se ha
+     *  anadido la medida <em>nombre</em> con los valores por operacion basica.
+    */
+    void medir(const string &nombre, const function<void()> &preparar,
+               const function<void()> &operacion, int operaciones);
+
+    /** @brief Modificadora que anota una reserva de memoria.
+     * \pre <em>cierto</em>
+     * \post Se ha incrementado el contador global de reservas. La llama el operator new del
+     *  programa de benchmarks.
+    */
+    static void anotar_reserva();
+
+    //Consultoras
+
+    /** @brief Consultora que compara las medidas con un fichero base.
+     * \pre <em>umbral</em> > 0
+     * \post Se ha escrito en el canal de salida, para cada medida, su valor, el del fichero
+     *  base y la variación. El resultado indica si ninguna medida presente en el fichero ha
+     *  empeorado en tiempo o reservas por operacion más de un <em>umbral</em> (por uno)
+     *  respecto a la base. Si el fichero no existe, no se compara nada: se crea con las
+     *  medidas actuales, como guardar, se avisa en el canal de salida y el resultado es cierto
+     *  (en un checkout nuevo, la primera ejecución solo registra). Si existe pero no se puede
+     *  leer, o no existe y no se puede crear, el resultado es falso.
+    */
+    bool comparar(const string &fichero_base, double umbral) const;
+
+    /** @brief Operacion de escriptura de las medidas en un fichero base.
+     * \pre <em>cierto</em>
+     * \post El resultado indica si se ha podido escribir <em>fichero</em> con una linea por
+     *  medida: nombre, nanosegundos, reservas y fallos de cache por operacion.
+    */
+    bool guardar(const string &fichero) const;
+
+    /** @brief Operacion de escriptura de las medidas.
+     * \pre <em>cierto</em>
+     * \post Se ha escrito en el canal de salida una linea por medida con sus valores.
+    */
+    void imprimir() const;
+
+
+    private:
+
+    /** @brief Valores por operacion de una medida. */
+    struct Medida {
+        string nombre;
+        double nanosegundos;
+        double reservas;
+        double fallos_cache;
+    };
+
+    /** @brief Medidas en el orden en que se han hecho. */
+    vector<Medida> medidas;
+
+    /** @brief Repeticiones de cada medida. */
+    int repeticiones;
+
+    /** @brief Descriptor del contador de fallos de cache de perf_event_open, -1 si no hay. */
+    int contador_cache;
+
+    /** @brief Reservas de memoria hechas por el programa. */
+    static atomic<long long> reservas;
+};
+
+#endif
\ No newline at end of file
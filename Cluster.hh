@@ -7,6 +7,16 @@
 
 #include "Procesador.hh"
 #include "Proceso.hh"
+#include "Traza.hh"
+#include "Identificadores.hh"
+
+#ifndef NO_DIAGRAM
+#include <vector>
+#include <set>
+#include <unordered_map>
+#include <memory>
+#endif
+
 /** @class Cluster
  *  @brief Esta clase hace referencia a un Cluster, un conjunto de procesadores (minimo 1) que
  *  realizan procesos y tareas. Permite anadir procesadores al Cluster, compactar la memoria de
@@ -16,6 +26,12 @@
  *  la memoria disponible. No obstante, dispone de un contador de tiempo, se puede avanzar el tiempo para
  *  terminar los procesos en ejecución. Por último, dispone de operaciones de lectura y escriptura a nivell
  *  de cluster y a nivell de procesador. 
+ *
+ *  Compilado con <em>-DPRO2_REFERENCIA</em> (make CONFIG=referencia) es el motor de referencia:
+ *  alta_proceso prueba todos los procesadores en anchura aplicando los criterios de desempate
+ *  uno a uno, sin el torneo de huecos ni el directorio, y avanzar_tiempo avanza cada procesador por
+ *  separado. Es lento a proposito; diferencial.cc lo usa como oraculo de las versiones
+ *  optimizadas, así que ninguna optimización se aplica en este modo.
 */
 class Cluster {
 
@@ -29,15 +45,36 @@ class Cluster {
     */
     Cluster();
 
+    /** @brief Creadora de una instantanea.
+    * \pre <em>cierto</em>
+    * \post El resultado es un Cluster con el mismo estado que el del parametro implicito que
+    * comparte con él los procesadores y los indices; cada uno copia un procesador o un indice
+    * solo al modificarlo, así que las modificaciones de uno no afectan al otro. Coste O(1). La
+    * primera modificación de un procesador copia su nodo, su bloque de nodos y el vector de
+    * bloques con el torneo de huecos (O(P/64)); el directorio y las finalizaciones solo se
+    * copian si la modificación los cambia.
+    */
+    Cluster instantanea() const;
+
+    /** @brief Creadora de una instantanea para simular envios.
+    * \pre <em>cierto</em>
+    * \post El resultado es como el de instantanea(), pero solo admite alta_proceso y las
+    * consultoras existe_procesador, espacio_procesador y max_espacio_cluster: no mantiene el
+    * directorio de procesos ni las finalizaciones, así que sus altas nunca los copian. Las
+    * altas en ella cuestan lo mismo que en el cluster, más la primera copia de cada nodo.
+    */
+    Cluster instantanea_simulacion() const;
+
     //Modificadoras
 
     /** @brief Modificadora que permite añadir (fusionar) un cluster a un otro.
      * \pre Existe el procesador p en el Cluster del parametro implicito y este procesador 
      * no tiene procesadores auxiliaries ni tampoco procesos en ejecución.
      * \post Se ha colocado el Cluster <em>c</em> del parametro en el lugar de <em>p</em>, substituyendo
-     * este por la raiz del Cluster del parametro.
+     * este por la raiz del Cluster del parametro. Los procesadores de <em>c</em> pasan a
+     * seguir el reloj del parametro implicito.
     */
-    void modificar_cluster (string id_procesador, const Cluster &c); //Requiere metodo privado
+    void modificar_cluster (Id id_procesador, const Cluster &c); //Requiere metodo privado
 
     /** @brief Modificadora que compacta la memoria de un procesador.
      * \pre  Existe un procesador con el el identificador como el parametro <em>id_procesador</em>
@@ -45,7 +82,16 @@ class Cluster {
      * \post Se han movido todos los procesos de la memoria del procesador <em>id_procesador</em>
      *  al principio, sin dejar huecos ni que se solapen entre procesos.
     */
-    void compactar_memoria_procesador(string id_procesador);
+    void compactar_memoria_procesador(Id id_procesador);
+
+    /** @brief Modificadora que compacta la memoria de un procesador solo hasta conseguir un
+     *  hueco de un tamano.
+     * \pre Existe un procesador con el identificador <em>id_procesador</em> en el cluster;
+     *  <em>objetivo</em> >= 0.
+     * \post Se ha aplicado Procesador::compactar_deslizando(<em>objetivo</em>) al procesador
+     *  <em>id_procesador</em> y el resultado es la memoria movida.
+    */
+    Tamano compactar_memoria_procesador(Id id_procesador, Tamano objetivo);
 
     /** @brief Modificadora que compacta las memorias de todos los procesadores del cluster.
      * \pre <em>cierto</em>
@@ -54,6 +100,14 @@ class Cluster {
     */
     void compactar_memoria_cluster();
 
+    /** @brief Modificadora que cambia el modelo de gestión de memoria de un procesador.
+     * \pre Existe un procesador con identificador <em>id_procesador</em> en el cluster y no
+     *  tiene procesos en ejecución. <em>modelo</em> es "huecos", "buddy" o "bitmap".
+     * \post La memoria del procesador <em>id_procesador</em> pasa a gestionarse con el modelo
+     *  <em>modelo</em>.
+    */
+    void modificar_modelo_memoria(Id id_procesador, const string &modelo);
+
     /** @brief Modificadora que envia un proceso a un procesador determinado. El proceso es
      *  colocado al hueco más ajustado.
      * \pre Existe un procesador con identificador de <em>id_procesador</em> que no tiene previamente
@@ -61,7 +115,15 @@ class Cluster {
      * \post Se ejecuta el proceso <em>job</em> en el procesador <em>id_procesador</em> del
      *  cluster del parametro implicito.
     */
-    void alta_proceso_procesador(string id_procesador, const Proceso &job);
+    void alta_proceso_procesador(Id id_procesador, const Proceso &job);
+
+    /** @brief Modificadora que envia un proceso a un procesador determinado moviendolo, sin
+     *  copiarlo.
+     * \pre Las mismas que la version con <em>const Proceso &</em>.
+     * \post Las mismas que la version con <em>const Proceso &</em>; <em>job</em> queda en un
+     *  estado valido pero no especificado.
+    */
+    void alta_proceso_procesador(Id id_procesador, Proceso &&job);
 
     /** @brief Modificadora que elimina un proceso que se esta ejecutando en un procesador del cluster.
      * \pre Existe un procesador con identificador <em>id_procesador</em> y esta ejecutando
@@ -69,24 +131,40 @@ class Cluster {
      * \post Se ha eliminado el proceso identificado como <em>id_job</em> que se estaba ejecutando 
      *  en un procesador nombrado <em>id_procesador</em> del cluster del parametro implicito.
     */
-    void baja_proceso_procesador(string id_procesador, int id_job); 
+    void baja_proceso_procesador(Id id_procesador, int id_job); 
 
     /** @brief Modificadora que envia un proceso a un procesador del cluster, se eligira el
      *  procesador con un hueco en la memoria más ajustado al requerido, en caso de empate,
      *  el que tenga más memoria libre. Si persiste el empate, el que se encuentra mas cerca
      *  del procesador principal. Como ultimo criterio de empate, el procesador que está más
-     *  a la izquierda.
+     *  a la izquierda. Los dos ultimos criterios equivalen a elegir el procesador con menor
+     *  posición en la disposición en anchura del arbol.
      * \pre <em>cierto</em>
      * \post El resultado indica si se ha podido colocar el proceso job en alguno de los
-     *  procesadores del cluster del parametro implicito.
+     *  procesadores del cluster del parametro implicito. Con marcadores (Marcador.hh), cada
+     *  llamada se marca como la fase "alta_proceso", también dentro de <em>epc</em>.
     */
     bool alta_proceso(const Proceso &job); 
 
+    /** @brief Modificadora que envia un proceso al procesador más optimo del cluster
+     *  moviendolo, sin copiarlo.
+     * \pre <em>cierto</em>
+     * \post El resultado indica si se ha podido colocar el proceso <em>job</em>, con el mismo
+     *  criterio que la version con <em>const Proceso &</em>. Si se ha podido, <em>job</em>
+     *  queda en un estado valido pero no especificado; si no, <em>job</em> no se ha modificado.
+     *  Se marca como la version con <em>const Proceso &</em>.
+    */
+    bool alta_proceso(Proceso &&job);
+
     /** @brief Modificadora el contador tiempo transcurrido.
      * \pre t >= 0.
-     * \post Se ha avanzado <em>t</em> unidades de tiempo.
+     * \post Se ha avanzado <em>t</em> unidades de tiempo. Si ningun proceso termina en las
+     *  <em>t</em> unidades, solo se avanza el reloj del cluster, con coste O(1). Si no, se
+     *  salta de una finalización a la siguiente en orden de instante y cada procesador que
+     *  tiene alguna se avanza hasta el nuevo reloj, eliminando a la vez, como antes, todos sus
+     *  procesos que terminan; los demás procesadores no se tocan.
     */  
-    void avanzar_tiempo(int t); 
+    void avanzar_tiempo(Tiempo t); 
 
     //Consultoras
 
@@ -94,7 +172,7 @@ class Cluster {
      * \pre <em>cierto</em>
      * \post El resultado indica si existe un procesador con identificador <em>id_procesador</em>.
     */  
-    bool existe_procesador(string id_procesador) const;
+    bool existe_procesador(Id id_procesador) const;
 
     /** @brief Consultora que indica si un procesador tiene procesador auxiliares.
      * \pre Existe un procesador en el cluster del parametro implicito identificado como
@@ -102,7 +180,7 @@ class Cluster {
      * \post El resultado indica si el procesador con identificador <em>id_procesador</em>
      *  tiene procesadores auxiliares.
     */  
-    bool vacio (string id_procesador) const;
+    bool vacio (Id id_procesador) const;
 
     /** @brief Consultora que indica si un procesador esta ocupado.
      * \pre Existe un procesador en el cluster del parametro implicito identificado como 
@@ -110,40 +188,95 @@ class Cluster {
      * \post El resultado indica si el procesador con identificador <em>id_procesador</em>
      *  tiene procesos pendientes.
     */  
-    bool procesador_ocupado (string id_procesador) const;
+    bool procesador_ocupado (Id id_procesador) const;
 
     /** @brief Consultora que indica la existencia de un proceso en un procesador del cluster.
      * \pre Existe un procesador en el cluster del parametro implicito identificado como
      * <em>id_procesador</em>.
      * \post El resultado indica si existe un proceso identificado como <em>id_job</em> en
      *  un procesador del cluster del parametro implicito, identificado como <em>id_procesador</em>.
+     *  Se consulta en el directorio de procesos, coste O(1) en media.
     */  
-    bool existe_proceso(string id_procesador, int id_job) const;
+    bool existe_proceso(Id id_procesador, int id_job) const;
+
+    /** @brief Consultora que indica si un proceso se esta ejecutando en el cluster.
+     * \pre <em>cierto</em>
+     * \post El resultado indica si algun procesador del cluster del parametro implicito
+     *  ejecuta un proceso identificado como <em>id_job</em>. Coste O(1) en media.
+    */
+    bool proceso_en_cluster(int id_job) const;
 
     /** @brief Consultora del tamaño del hueco más grande en la memoria de un procesador.
      * \pre El procesador con <em>id_procesador</em> existe en el cluster del parametro implicito.
      * \post El resultado indica el tamano del hueco más grande en el procesador <em>id_procesador</em>
      *  del cluster del parametro implicito.
     */
-    int espacio_procesador (string id_procesador) const;
+    Tamano espacio_procesador (Id id_procesador) const;
+
+    /** @brief Consultora de la fragmentación interna de la memoria de un procesador.
+     * \pre El procesador con <em>id_procesador</em> existe en el cluster del parametro implicito.
+     * \post El resultado es la memoria reservada y no pedida por los procesos del procesador
+     *  <em>id_procesador</em> por el redondeo a potencias de dos del modelo "buddy".
+    */
+    Tamano fragmentacion_interna_procesador (Id id_procesador) const;
+
+    /** @brief Consultora del tamaño del hueco más grande del cluster.
+     * \pre <em>cierto</em>
+     * \post El resultado es el tamano del hueco más grande de todos los procesadores del
+     *  cluster del parametro implicito; ningun proceso que requiera más memoria cabe en el.
+     *  Coste O(1).
+    */
+    Tamano max_espacio_cluster () const;
 
     //Lectura y Escriptura
 
     /** @brief Operacion de lectura de Cluster.
      * \pre <em>Cierto></em>
      * \post El Cluster del parametro implicito queda inicializado con los procesadores y 
-     * sus respectivas memorias.
+     * sus respectivas memorias. Los identificadores de los procesadores quedan internados en
+     * Identificadores. El resultado indica si todas las memorias leidas son validas
+     * (Procesador::configurar_procesador); si no, el cluster no se debe usar.
     */  
-    void configurar_cluster (); //requiere metodos en privado.
+    bool configurar_cluster (); //requiere metodos en privado.
+
+    /** @brief Operacion de lectura de Cluster desde una traza.
+     * \pre <em>t</em> está abierta en modo reproducción y el siguiente dato es la
+     *  configuración de un cluster.
+     * \post El Cluster del parametro implicito queda inicializado con los procesadores y
+     *  sus respectivas memorias leidos de <em>t</em>.
+    */
+    void configurar_cluster (Traza &t);
+
+    /** @brief Operacion de lectura de Cluster desde un Lector.
+     * \pre Hay en <em>entrada</em> la configuración de un cluster.
+     * \post El Cluster del parametro implicito queda inicializado con los procesadores y
+     *  sus respectivas memorias leidos de <em>entrada</em>. El resultado indica si todas las
+     *  memorias leidas son validas, como en configurar_cluster().
+    */
+    bool configurar_cluster (Lector &entrada);
+
+    /** @brief Operacion de escriptura de la configuración del Cluster en una traza.
+     * \pre <em>t</em> está abierta en modo grabación.
+     * \post Se ha anadido a <em>t</em> la estructura del Cluster en preorden, con el
+     *  identificador y la memoria de cada procesador, de manera que configurar_cluster(t)
+     *  reconstruye un Cluster igual al del parametro implicito sin procesos.
+    */
+    void escribir_configuracion (Traza &t) const;
 
     /** @brief Operacion de escriptura del Cluster.
      * \pre <em>Cierto</em>
      * \post Se escribe en el canal de salida, para todos los procesadores por orden creciente
-     *  de identificador, los procesos que se esta ejecutando, empezando por la primera posición
+     *  de identificador (orden alfabetico del texto, no del Id), los procesos que se esta ejecutando, empezando por la primera posición
      *  de memoria en orden creciente los datos de cada proceso.
     */  
     void imprimir_procesador_cluster() const;
 
+    /** @brief Operacion de escriptura en un canal.
+     * \pre Las mismas que imprimir_procesador_cluster().
+     * \post Se escribe en <em>os</em> lo mismo que imprimir_procesador_cluster() escribe en el canal de salida.
+    */
+    void imprimir_procesador_cluster(ostream &os) const;
+
     /** @brief Operacion de escriptura del Cluster.
      * \pre <em>Cierto></em>
      * \post Se ha escrito la estructura los procesadores del Cluster del parametro implicito
@@ -151,16 +284,136 @@ class Cluster {
     */    
     void imprimir_estructura_cluster() const; //Requiere metodo privado.
 
+    /** @brief Operacion de escriptura en un canal.
+     * \pre Las mismas que imprimir_estructura_cluster().
+     * \post Se escribe en <em>os</em> lo mismo que imprimir_estructura_cluster() escribe en el canal de salida.
+    */
+    void imprimir_estructura_cluster(ostream &os) const;
+
     /** @brief Operacion de escriptura del procesador.
      * \pre <em>cierto</em>
      * \post Se escribe por orden creciente de primera posición de memoria en el canal de 
      * salida los procesos que se esta ejecutando en el procesador con identificador <em>id_procesador</em>
      * y su posición de memoria, juntamente con los datos de cada proceso.
     */
-    void imprimir_procesador(string id_procesador) const;
+    void imprimir_procesador(Id id_procesador) const;
+
+    /** @brief Operacion de escriptura en un canal.
+     * \pre Las mismas que imprimir_procesador(<em>id_procesador</em>).
+     * \post Se escribe en <em>os</em> lo mismo que imprimir_procesador(<em>id_procesador</em>) escribe en el canal de salida.
+    */
+    void imprimir_procesador(Id id_procesador, ostream &os) const;
+
+    /** @brief Operacion de escriptura de la ubicación de un proceso.
+     * \pre El cluster del parametro implicito ejecuta algun proceso identificado como
+     *  <em>id_job</em>.
+     * \post Se escriben en el canal de salida, uno por linea y por orden creciente de
+     *  identificador, los procesadores del cluster que ejecutan el proceso <em>id_job</em>.
+    */
+    void imprimir_ubicacion_proceso(int id_job) const;
+
+    /** @brief Operacion de escriptura en un canal.
+     * \pre Las mismas que imprimir_ubicacion_proceso(<em>id_job</em>).
+     * \post Se escribe en <em>os</em> lo mismo que imprimir_ubicacion_proceso(<em>id_job</em>) escribe en el canal de salida.
+    */
+    void imprimir_ubicacion_proceso(int id_job, ostream &os) const;
     
     
     private:
 
+    /** @brief Procesador del cluster junto con su posición en el arbol. */
+    struct Nodo {
+        /** @brief Procesador del nodo. */
+        Procesador p;
+        /** @brief Posiciones en orden de anchura de los procesadores auxiliares izquierdo y
+         *  derecho, -1 si no tiene. */
+        int izq, der;
+        /** @brief Distancia al procesador principal. */
+        int profundidad;
+        /** @brief Posición de izquierda a derecha dentro de su nivel. */
+        int rango;
+        /** @brief Reloj del cluster hasta el que se ha avanzado <em>p</em>. Entre este instante
+         *  y el reloj del cluster no termina ningun proceso de <em>p</em>. */
+        long long reloj;
+    };
+
+    /** @brief Numero de nodos de un bloque. */
+    static const int NODOS_BLOQUE = 64;
+
+    /** @brief Nodos consecutivos en orden de anchura con el hueco más grande de sus
+     *  procesadores. */
+    struct Bloque {
+        shared_ptr<Nodo> nodos[NODOS_BLOQUE];
+        Tamano max_hueco;
+    };
+
+    /** @brief Estado del cluster, compartido entre un cluster y sus instantaneas. Cada indice
+     *  se comparte por separado, de manera que una modificación solo copia los que cambia. */
+    struct Estado {
+        /** @brief Procesadores del cluster en orden de recorrido en anchura, por bloques de
+         *  NODOS_BLOQUE: el procesador principal en la posición 0 y cada nivel de izquierda a
+         *  derecha. Así la posición de un nodo ya es la clave de desempate (profundidad, rango)
+         *  de alta_proceso y los recorridos de todo el cluster son secuenciales en memoria.
+         *  Cada bloque y cada nodo se comparten por separado: modificar un procesador
+         *  compartido copia este vector (P/64 punteros), su bloque y su nodo. */
+        vector< shared_ptr<Bloque> > bloques;
+
+        /** @brief Numero de procesadores del cluster. */
+        int procesadores;
+
+        /** @brief Posición de cada procesador, indexado por Id; -1 si el Id no es de ningun
+         *  procesador del cluster. Solo cambia con la estructura (cc, mc), así que las altas y
+         *  bajas de una instantanea no lo copian. */
+        shared_ptr< vector<int> > posicion;
+
+        /** @brief Torneo de maximos sobre el hueco más grande de cada bloque: la posición 1
+         *  es la raiz y max_espacio_cluster(), los hijos de k son 2k y 2k+1 y las hojas son los
+         *  bloques. Se actualiza en cada alta, baja, fin de proceso, compactación y cambio de
+         *  estructura, con coste O(NODOS_BLOQUE + log P). */
+        vector<Tamano> torneo;
+
+        /** @brief Directorio de procesos: para cada identificador de proceso en ejecución,
+         *  los procesadores que lo ejecutan. Se actualiza al colocar un proceso (app, epc), al
+         *  eliminarlo (bpp) y cuando termina en avanzar_tiempo. Nulo en las instantaneas de
+         *  simulación. */
+        shared_ptr< unordered_map< int, vector<Id> > > directorio;
+
+        /** @brief Reloj del cluster: suma de todos los avances de tiempo. Es de 64 bits
+         *  aunque Tiempo no lo sea, porque acumula todos los <em>at</em> de la sesión. */
+        long long reloj;
+
+        /** @brief Siguiente finalización de cada procesador con procesos: el instante del
+         *  reloj del cluster en que termina su primer proceso (reloj del nodo mas
+         *  proxima_finalizacion()) y su Id. Se guarda el Id y no la posición en orden de
+         *  anchura porque <em>mc</em> recoloca los niveles inferiores (reordenar_desde_nivel);
+         *  la posición se consulta en <em>posicion</em>. El primer elemento es la siguiente
+         *  finalización del cluster. Se actualiza al modificar un procesador. Nulo en las
+         *  instantaneas de simulación. */
+        shared_ptr< set< pair<long long, Id> > > finalizaciones;
+    };
+
+    /** @brief Estado del cluster. Si lo comparte con alguna instantanea, se copia antes de la
+     *  primera modificación; la copia solo duplica el vector de bloques y el torneo y comparte
+     *  los demás indices hasta que se modifican. */
+    shared_ptr<Estado> estado;
+
+    /** @brief Operacion que prepara la modificación de un procesador.
+     * \pre 0 <= <em>i</em> < <em>procesadores</em>.
+     * \post <em>estado</em> y el nodo <em>i</em> ya no se comparten con ninguna instantanea y
+     *  su procesador se ha avanzado hasta el reloj del cluster. El resultado es el nodo
+     *  <em>i</em>, que se puede modificar; quien lo modifica actualiza su finalización.
+    */
+    Nodo &nodo_modificable(int i);
+
+    /** @brief Operacion que rehace la disposición a partir de un nivel.
+     * \pre Los niveles menores que <em>nivel</em> están bien colocados en <em>bloques</em> y los
+     *  campos <em>izq</em> y <em>der</em> de todos los nodos son correctos.
+     * \post Se han recolocado en orden de anchura los nodos de profundidad >= <em>nivel</em>,
+     *  recalculando su profundidad, rango, sus posiciones en <em>posicion</em>, el hueco más
+     *  grande (<em>max_hueco</em>) de cada bloque donde ha entrado o salido algun nodo y el
+     *  torneo. Las finalizaciones no cambian, porque van por Id. Lo usa modificar_cluster para
+     *  no recolocar los niveles que no cambian.
+    */
+    void reordenar_desde_nivel(int nivel);
 };
 #endif
\ No newline at end of file
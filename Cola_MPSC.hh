@@ -0,0 +1,118 @@
+/** @file Cola_MPSC.hh
+    @brief Especificación e implementación de la clase Cola_MPSC. Al ser una plantilla, las
+    operaciones se definen en la cabecera para que se puedan instanciar.
+*/
+
+#ifndef COLA_MPSC_HH
+#define COLA_MPSC_HH
+
+#ifndef NO_DIAGRAM
+#include <vector>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+using namespace std;
+#endif
+
+/** @class Cola_MPSC
+    @brief Cola circular acotada sin bloqueos para varios productores y un unico consumidor.
+    Cada casilla lleva un numero de turno: un productor reserva una casilla incrementando
+    atomicamente el indice final y la publica actualizando su turno, de manera que los
+    productores no se bloquean entre ellos y el consumidor solo lee casillas ya publicadas.
+*/
+template <class T> class Cola_MPSC {
+
+    public:
+
+    //Constructoras
+
+    /** @brief Creadora con capacidad.
+     * \pre <em>capacidad</em> > 0 y es potencia de dos.
+     * \post El resultado es una cola vacia que admite hasta <em>capacidad</em> elementos.
+    */
+    Cola_MPSC(int capacidad);
+
+    //Modificadoras
+
+    /** @brief Modificadora que anade un elemento al final de la cola.
+     * \pre Puede llamarla cualquier hilo, concurrentemente con otros productores y con el
+     *  consumidor.
+     * \post El resultado indica si habia sitio en la cola. Si lo habia, <em>x</em> se ha movido
+     *  a una casilla de la cola y es visible para el consumidor.
+    */
+    bool encolar(T &&x);
+
+    /** @brief Modificadora que extrae el primer elemento publicado de la cola.
+     * \pre Solo la llama el hilo consumidor.
+     * \post El resultado indica si la primera casilla estaba publicada. Si lo estaba, se ha
+     *  movido su elemento a <em>x</em> y la casilla queda libre para los productores.
+    */
+    bool desencolar(T &x);
+
+    //Consultoras
+
+    /** @brief Consultora que indica si la cola está vacia.
+     * \pre Solo la llama el hilo consumidor.
+     * \post El resultado indica si en algun momento durante la llamada no habia ninguna
+     *  casilla reservada por leer, publicada o no.
+    */
+    bool vacia() const;
+
+
+    private:
+
+    /** @brief Casilla de la cola con su numero de turno. */
+    struct Casilla {
+        atomic<size_t> turno;
+        T valor;
+    };
+
+    /** @brief Casillas de la cola; la casilla de un indice es indice & (capacidad - 1). */
+    vector<Casilla> buffer;
+
+    /** @brief Indice de la siguiente casilla a leer, solo lo escribe el consumidor. */
+    alignas(64) size_t inicio;
+
+    /** @brief Indice de la siguiente casilla a reservar, compartido por los productores. */
+    alignas(64) atomic<size_t> fin;
+};
+
+// Una casilla con turno == i está libre para el productor que reserve el indice i; con
+// turno == i + 1 está publicada para el consumidor que lee el indice i.
+
+template <class T> Cola_MPSC<T>::Cola_MPSC(int capacidad) : buffer(capacidad), inicio(0), fin(0) {
+    for (size_t i = 0; i < buffer.size(); ++i) buffer[i].turno.store(i, memory_order_relaxed);
+}
+
+template <class T> bool Cola_MPSC<T>::encolar(T &&x) {
+    size_t pos = fin.load(memory_order_relaxed);
+    while (true) {
+        Casilla &c = buffer[pos & (buffer.size() - 1)];
+        ptrdiff_t diferencia = ptrdiff_t(c.turno.load(memory_order_acquire) - pos);
+        if (diferencia == 0) {
+            // Reserva la casilla; si otro productor se adelanta, pos pasa a ser el nuevo fin.
+            if (fin.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                c.valor = std::move(x);
+                c.turno.store(pos + 1, memory_order_release);
+                return true;
+            }
+        }
+        else if (diferencia < 0) return false;
+        else pos = fin.load(memory_order_relaxed);
+    }
+}
+
+template <class T> bool Cola_MPSC<T>::desencolar(T &x) {
+    Casilla &c = buffer[inicio & (buffer.size() - 1)];
+    if (c.turno.load(memory_order_acquire) != inicio + 1) return false;
+    x = std::move(c.valor);
+    c.turno.store(inicio + buffer.size(), memory_order_release);
+    ++inicio;
+    return true;
+}
+
+template <class T> bool Cola_MPSC<T>::vacia() const {
+    return fin.load(memory_order_acquire) == inicio;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,96 @@
+/** @file Cola_SPSC.hh
+    @brief Especificación e implementación de la clase Cola_SPSC. Al ser una plantilla, las
+    operaciones se definen en la cabecera para que se puedan instanciar.
+*/
+
+#ifndef COLA_SPSC_HH
+#define COLA_SPSC_HH
+
+#ifndef NO_DIAGRAM
+#include <vector>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+using namespace std;
+#endif
+
+/** @class Cola_SPSC
+    @brief Cola circular acotada sin bloqueos para un unico productor y un unico consumidor,
+    cada uno en su propio hilo. El productor solo escribe el indice final y el consumidor solo
+    el inicial, de manera que ninguna operación usa mutex ni espera al otro hilo. Se usa para
+    comunicar hilos del simulador que tienen un unico emisor y un unico receptor.
+*/
+template <class T> class Cola_SPSC {
+
+    public:
+
+    //Constructoras
+
+    /** @brief Creadora con capacidad.
+     * \pre <em>capacidad</em> > 0 y es potencia de dos.
+     * \post El resultado es una cola vacia que admite hasta <em>capacidad</em> elementos.
+    */
+    Cola_SPSC(int capacidad);
+
+    //Modificadoras
+
+    /** @brief Modificadora que anade un elemento al final de la cola.
+     * \pre Solo la llama el hilo productor.
+     * \post El resultado indica si habia sitio en la cola. Si lo habia, <em>x</em> se ha movido
+     *  al final de la cola y es visible para el consumidor.
+    */
+    bool encolar(T &&x);
+
+    /** @brief Modificadora que extrae el primer elemento de la cola.
+     * \pre Solo la llama el hilo consumidor.
+     * \post El resultado indica si la cola tenia algun elemento. Si lo tenia, se ha movido el
+     *  primero a <em>x</em> y se ha eliminado de la cola.
+    */
+    bool desencolar(T &x);
+
+    //Consultoras
+
+    /** @brief Consultora que indica si la cola está vacia.
+     * \pre <em>cierto</em>
+     * \post El resultado indica si la cola estaba vacia en algun momento durante la llamada.
+    */
+    bool vacia() const;
+
+
+    private:
+
+    /** @brief Elementos de la cola; la posición de un indice es indice & (capacidad - 1). */
+    vector<T> buffer;
+
+    /** @brief Indice del primer elemento, solo lo escribe el consumidor. Alineado a una linea
+     *  de cache para que productor y consumidor no compartan linea. */
+    alignas(64) atomic<size_t> inicio;
+
+    /** @brief Indice siguiente al ultimo elemento, solo lo escribe el productor. */
+    alignas(64) atomic<size_t> fin;
+};
+
+template <class T> Cola_SPSC<T>::Cola_SPSC(int capacidad) : buffer(capacidad), inicio(0), fin(0) {
+}
+
+template <class T> bool Cola_SPSC<T>::encolar(T &&x) {
+    size_t f = fin.load(memory_order_relaxed);
+    if (f - inicio.load(memory_order_acquire) == buffer.size()) return false;
+    buffer[f & (buffer.size() - 1)] = std::move(x);
+    fin.store(f + 1, memory_order_release);
+    return true;
+}
+
+template <class T> bool Cola_SPSC<T>::desencolar(T &x) {
+    size_t i = inicio.load(memory_order_relaxed);
+    if (i == fin.load(memory_order_acquire)) return false;
+    x = std::move(buffer[i & (buffer.size() - 1)]);
+    inicio.store(i + 1, memory_order_release);
+    return true;
+}
+
+template <class T> bool Cola_SPSC<T>::vacia() const {
+    return inicio.load(memory_order_acquire) == fin.load(memory_order_acquire);
+}
+
+#endif
\ No newline at end of file
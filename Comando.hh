@@ -0,0 +1,162 @@
+/** @file Comando.hh
+    @brief Especificación de la clase Comando.
+*/
+
+#ifndef COMANDO_HH
+#define COMANDO_HH
+
+#include "Cluster.hh"
+#include "Proceso.hh"
+#include "Traza.hh"
+#include "Lector.hh"
+
+/** @class Comando
+    @brief Comando del programa principal ya analizado: su tipo y sus argumentos (identificador
+    de procesador o prioridad, modelo de memoria, entero, proceso o cluster). Separa la lectura
+    de un comando de su ejecución, de manera que un comando se puede leer del canal de entrada
+    o de una traza binaria y escribir en una traza.
+*/
+class Comando {
+
+    public:
+
+    /** @brief Tipos de comando. DESCONOCIDO corresponde a una palabra que no es ningun
+     *  comando y que el programa principal ignora. */
+    enum Tipo { CC, MC, AP, BP, APE, APP, BPP, EPC, AT, IPRI, IAE, IPRO, IPC, IEC,
+                CMP, CMC, MMP, IFP, BPC, SEPC, IMR, CDP, FIN, DESCONOCIDO };
+
+    //Constructoras
+
+    /** @brief Creadora por defecto.
+     * \pre <em>cierto</em>
+     * \post El resultado es un comando de tipo FIN sin argumentos.
+    */
+    Comando();
+
+    //Consultoras
+
+    /** @brief Consultora del tipo del comando.
+     * \pre <em>cierto</em>
+     * \post El resultado es el tipo del comando del parametro implicito.
+    */
+    Tipo consultar_tipo() const;
+
+    /** @brief Consultora del identificador de procesador o prioridad del comando.
+     * \pre El comando es de tipo MC, AP, BP, APE, APP, BPP, IPRI, IPRO, CMP, MMP, IFP o CDP.
+     * \post El resultado es el identificador de procesador o prioridad del comando.
+    */
+    Id consultar_id() const;
+
+    /** @brief Consultora del modelo de memoria del comando.
+     * \pre El comando es de tipo MMP.
+     * \post El resultado es el modelo de memoria del comando.
+    */
+    const string &consultar_modelo() const;
+
+    /** @brief Consultora del argumento entero del comando.
+     * \pre El comando es de tipo BPP, EPC, AT, BPC, SEPC o CDP.
+     * \post El resultado es el identificador de proceso (BPP y BPC), el numero de procesos
+     *  (EPC y SEPC), el tiempo (AT) o el tamano del hueco pedido (CDP) del comando.
+    */
+    long long consultar_entero() const;
+
+    /** @brief Consultora que indica si el argumento entero cabe en el tipo que lo usa.
+     * \pre El comando es de tipo BPP, EPC, AT, BPC, SEPC o CDP.
+     * \post El resultado indica si consultar_entero() cabe en un int (BPP y BPC), es un int
+     *  no negativo (EPC y SEPC) o cabe en Tiempo (AT) o Tamano (CDP) sin ser negativo. Si no,
+     *  el comando no se debe ejecutar: convertir el entero lo truncaria (por ejemplo,
+     *  <em>bpp p 4294967297</em> actuaria sobre el proceso 1).
+    */
+    bool entero_valido() const;
+
+    /** @brief Consultora que indica si el proceso o el cluster leido cabe en sus tipos.
+     * \pre El comando es de tipo APE, APP, CC o MC.
+     * \post El resultado indica si los enteros del proceso (APE y APP, Proceso::leer) o las
+     *  memorias de los procesadores del cluster (CC y MC, Cluster::configurar_cluster) cabian
+     *  en sus tipos al leerlos. Si no, el comando no se debe ejecutar, por el mismo motivo que
+     *  con entero_valido (<em>ape 4294967297 5 5 pr0</em> encolaria el proceso 1).
+    */
+    bool datos_validos() const;
+
+    /** @brief Consultora del proceso del comando.
+     * \pre El comando es de tipo APE o APP.
+     * \post El resultado es el proceso del comando.
+    */
+    const Proceso &consultar_proceso() const;
+
+    /** @brief Consultora del cluster del comando.
+     * \pre El comando es de tipo CC o MC.
+     * \post El resultado es el cluster leido con el comando.
+    */
+    const Cluster &consultar_cluster() const;
+
+    //Modificadoras
+
+    /** @brief Modificadora que extrae el proceso del comando.
+     * \pre El comando es de tipo APE o APP.
+     * \post El resultado es el proceso del comando, movido fuera de él.
+    */
+    Proceso extraer_proceso();
+
+    /** @brief Modificadora que extrae el cluster del comando.
+     * \pre El comando es de tipo CC o MC.
+     * \post El resultado es el cluster del comando, movido fuera de él.
+    */
+    Cluster extraer_cluster();
+
+    //Lectura y escriptura
+
+    /** @brief Operacion de lectura de un comando del canal de entrada.
+     * \pre Hay en el canal de entrada un comando con sus argumentos en formato de texto.
+     * \post El comando del parametro implicito pasa a ser el comando leido. El identificador
+     *  de procesador o prioridad se ha internado en Identificadores.
+    */
+    void leer();
+
+    /** @brief Operacion de lectura de un comando de una traza.
+     * \pre <em>t</em> está abierta en modo reproducción y el siguiente dato es un comando.
+     * \post El comando del parametro implicito pasa a ser el comando leido de <em>t</em>.
+    */
+    void leer(Traza &t);
+
+    /** @brief Operacion de lectura de un comando desde un Lector.
+     * \pre Hay en <em>entrada</em> un comando con sus argumentos en formato de texto.
+     * \post El comando del parametro implicito pasa a ser el comando leido. El identificador
+     *  de procesador o prioridad se ha internado en Identificadores.
+    */
+    void leer(Lector &entrada);
+
+    /** @brief Operacion de escriptura de un comando en una traza.
+     * \pre <em>t</em> está abierta en modo grabación. El comando no es DESCONOCIDO.
+     * \post Se ha anadido a <em>t</em> el tipo del comando y sus argumentos. Si
+     *  datos_validos() es falso también se graba, de manera que el comando reproducido tampoco
+     *  se ejecuta.
+    */
+    void escribir(Traza &t) const;
+
+
+    private:
+
+    /** @brief Tipo del comando. */
+    Tipo tipo;
+
+    /** @brief Identificador de procesador o prioridad. */
+    Id id;
+
+    /** @brief Modelo de memoria. */
+    string modelo;
+
+    /** @brief Argumento entero, de 64 bits para admitir tiempos de cualquier anchura. */
+    long long entero;
+
+    /** @brief Proceso de APE y APP. */
+    Proceso job;
+
+    /** @brief Cluster de CC y MC. */
+    Cluster c;
+
+    /** @brief Si el proceso o el cluster leido cabia en sus tipos. */
+    bool validos;
+};
+
+#endif
\ No newline at end of file
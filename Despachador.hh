@@ -0,0 +1,142 @@
+/** @file Despachador.hh
+    @brief Especificación de la clase Despachador.
+*/
+
+#ifndef DESPACHADOR_HH
+#define DESPACHADOR_HH
+
+#include "Cluster.hh"
+#include "Area_de_Espera.hh"
+#include "Comando.hh"
+#include "Ejecutor.hh"
+#include "Cola_SPSC.hh"
+#include "Identificadores.hh"
+
+#ifndef NO_DIAGRAM
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <string>
+#endif
+
+/** @class Despachador
+    @brief Simulador particionado en N clusters independientes ("particiones"), cada uno
+    propiedad de su propio hilo. El despachador tiene la area de espera, recibe los comandos
+    del programa principal y los reparte: los comandos con identificador de procesador van a
+    la partición propietaria de ese procesador, y los procesos de <em>epc</em> a la partición
+    con más espacio libre. Las particiones y el despachador se comunican solo mediante colas
+    Cola_SPSC: una de comandos y una de respuestas (salida y estado) por partición. La salida
+    de <em>ipc</em> e <em>iec</em> se combina de manera determinista.
+*/
+class Despachador {
+
+    public:
+
+    //Constructoras
+
+    /** @brief Creadora con numero de particiones.
+     * \pre <em>n</em> > 0
+     * \post El resultado es un despachador con <em>n</em> particiones vacias, cada una con su
+     *  hilo en marcha, y una area de espera sin prioridades.
+    */
+    Despachador(int n);
+
+    /** @brief Destructora.
+     * \pre <em>cierto</em>
+     * \post Se han detenido y esperado los hilos de todas las particiones.
+    */
+    ~Despachador();
+
+    //Modificadora
+
+    /** @brief Modificadora que ejecuta un comando.
+     * \pre <em>com</em> no es de tipo FIN, DESCONOCIDO ni CC.
+     * \post Se ha aplicado <em>com</em> al simulador particionado y se ha escrito su salida en
+     *  el canal de salida antes de la salida de cualquier comando posterior. Los comandos se
+     *  aplican con las operaciones de Ejecutor.hh, como en el programa principal, así que las
+     *  comprobaciones y los errores son los mismos. Un comando con el entero fuera de rango
+     *  solo escribe "ERROR: Entero fuera de rango" (entero_fuera_de_rango, antes de
+     *  repartirlo). En concreto:
+     *  - MC, APP, BPP, IPRO, CMP, MMP, IFP y CDP se envian a la partición propietaria del
+     *    procesador, que se consulta en el mapa de propietarios y los aplica con
+     *    ejecutar_comando_cluster; si no hay ninguna, se escribe el error "El procesador no
+     *    existe". Un MC aplicado anade al mapa de propietarios los procesadores del cluster
+     *    nuevo.
+     *  - AP, BP, APE, IPRI, IAE e IMR se aplican a la area de espera del despachador con
+     *    ejecutar_comando_area.
+     *  - EPC se envia a todas las particiones. Cada una, en su hilo y despues de los comandos
+     *    anteriores, responde y se detiene hasta que el despachador ha hecho
+     *    Area_de_Espera::enviar_procesos_cluster(n, particiones) sobre sus clusters, que
+     *    extrae los procesos por el orden de <em>epc</em> y envia cada uno a la partición con
+     *    el hueco más grande (en caso de empate, la de menor indice); si no cabe en esa, es
+     *    rechazado y vuelve a su prioridad. Despues el despachador anota el hueco más grande de
+     *    cada partición y las deja continuar.
+     *  - AT y CMC se envian a todas las particiones, que los aplican en paralelo con
+     *    ejecutar_comando_cluster.
+     *  - SEPC se envia a todas las particiones. Cada una, en su hilo y despues de los
+     *    comandos anteriores, responde con una instantanea de simulación de su cluster y se
+     *    detiene hasta que el despachador ha hecho Area_de_Espera::simular_envio sobre todas y
+     *    ha destruido las instantaneas. Así, con EPC y SEPC, ningun cluster se modifica ni se
+     *    copia desde dos hilos a la vez.
+     *  - BPC se consulta en todas las particiones y sus respuestas se combinan por orden
+     *    creciente de identificador de procesador.
+     *  - IPC escribe los procesadores de todas las particiones por orden creciente de
+     *    identificador; IEC escribe la estructura de cada partición por orden de indice.
+     *  Con marcadores (Marcador.hh), cada comando que aplica una partición se marca en su hilo
+     *  como la fase "particion", y el envio de EPC en el hilo del despachador como
+     *  "enviar_procesos_cluster".
+    */
+    void ejecutar(Comando &com);
+
+    //Lectura
+
+    /** @brief Operacion de lectura de la configuración inicial.
+     * \pre Hay en el canal de entrada N configuraciones de cluster, una por partición, seguidas
+     *  del numero de prioridades y sus identificadores. Ningun procesador aparece en más de una.
+     * \post Cada partición queda configurada con su cluster, el mapa de propietarios contiene
+     *  todos sus procesadores y la area de espera tiene las prioridades leidas. El resultado
+     *  indica si todas las memorias leidas son validas (Cluster::configurar_cluster); si no,
+     *  el despachador no se debe usar.
+    */
+    bool configurar();
+
+
+    private:
+
+    /** @brief Mensaje de una partición al despachador: salida del ultimo comando y espacio del
+     *  hueco más grande de la partición después de aplicarlo. El hilo de la partición escribe
+     *  la salida en un ostringstream propio con las versiones con <em>ostream &</em> de las
+     *  operaciones de escriptura, porque redirigir cout afectaria a todos los hilos. */
+    struct Respuesta {
+        string salida;
+        Tamano max_hueco;
+        /** @brief Instantanea de simulación del cluster, solo en la respuesta a SEPC. */
+        Cluster instantanea;
+    };
+
+    /** @brief Una partición: su cluster, su hilo y sus colas. */
+    struct Particion {
+        Cluster c;
+        thread hilo;
+        Cola_SPSC<Comando> comandos;
+        Cola_SPSC<Respuesta> respuestas;
+        /** @brief Ultimo hueco más grande conocido de la partición. */
+        Tamano max_hueco;
+        /** @brief Lo pone a cierto el despachador al terminar un EPC o un SEPC; hasta entonces
+         *  el hilo de la partición no ejecuta ningun otro comando ni toca su cluster. */
+        atomic<bool> reanudar;
+    };
+
+    /** @brief Particiones del simulador, reservadas con new. Contienen colas alineadas a 64
+     *  bytes, y new solo respeta esa alineación desde C++17. */
+    static_assert(__cplusplus >= 201703L, "Despachador requiere C++17 o posterior (new alineado)");
+    vector<Particion *> particiones;
+
+    /** @brief Partición propietaria de cada procesador, indexado por Id; -1 si no hay. */
+    vector<int> propietario;
+
+    /** @brief Area de espera compartida por todas las particiones. */
+    Area_de_Espera ae;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,224 @@
+/** @file Ejecutor.cc
+    @brief Código de la ejecución de los comandos del simulador.
+*/
+
+#include "Ejecutor.hh"
+#include "Identificadores.hh"
+#include "Marcador.hh"
+
+#ifndef NO_DIAGRAM
+#include <fstream>
+#include <string>
+#endif
+
+bool entero_fuera_de_rango(const Comando &com, ostream &os) {
+    Comando::Tipo tipo = com.consultar_tipo();
+    bool fuera = false;
+    if (tipo == Comando::BPP or tipo == Comando::EPC or tipo == Comando::AT
+        or tipo == Comando::BPC or tipo == Comando::SEPC or tipo == Comando::CDP) {
+        fuera = not com.entero_valido();
+    }
+    else if (tipo == Comando::APE or tipo == Comando::APP or tipo == Comando::CC
+             or tipo == Comando::MC) {
+        fuera = not com.datos_validos();
+    }
+    if (fuera) os << "ERROR: Entero fuera de rango" << endl;
+    return fuera;
+}
+
+void ejecutar_comando_cluster(Comando &com, Cluster &c1, ostream &os) {
+
+    Comando::Tipo tipo = com.consultar_tipo();
+
+    if (entero_fuera_de_rango(com, os)) return;
+
+    if (tipo == Comando::CC) {
+        c1 = com.extraer_cluster();
+    }
+    else if (tipo == Comando::MC){
+        Id id_procesador = com.consultar_id();
+
+        if (not c1.existe_procesador(id_procesador))
+        os << "ERROR: El procesador no existe" << endl;
+        else if(not c1.vacio(id_procesador))
+        os << "ERROR: El procesador tiene procesadores auxiliares dependientes" << endl;
+        else if (c1.procesador_ocupado(id_procesador))
+        os << "ERROR: El procesador tiene procesos en ejecucion" << endl;
+        else c1.modificar_cluster(id_procesador,com.extraer_cluster());
+    }
+    else if (tipo == Comando::APP){
+        Id id_procesador = com.consultar_id();
+        Proceso job = com.extraer_proceso();
+
+        if (not c1.existe_procesador(id_procesador))
+        os << "ERROR: El procesador no existe" << endl;
+        else if(c1.existe_proceso(id_procesador,job.consultar_id()))
+        os << "ERROR: El proceso ya existe en el procesador" << endl;
+        else if (c1.espacio_procesador(id_procesador) < job.consultar_tamano())
+        os << "ERROR: No hay suficiente espacio en la memoria" << endl;
+        else {
+            MARCADOR("alta_proceso_procesador");
+            c1.alta_proceso_procesador(id_procesador, std::move(job));
+        }
+    }
+    else if (tipo == Comando::BPP){
+        Id id_procesador = com.consultar_id();
+        int id_job = com.consultar_entero();
+
+        if (not c1.existe_procesador(id_procesador))
+        os << "ERROR: El procesador no existe" << endl;
+        else if(not c1.existe_proceso(id_procesador,id_job))
+        os << "ERROR: El proceso no existe en el procesador" << endl;
+        else c1.baja_proceso_procesador(id_procesador, id_job);
+    }
+    else if (tipo == Comando::AT){
+        MARCADOR("avanzar_tiempo");
+        c1.avanzar_tiempo(com.consultar_entero());
+    }
+    else if (tipo == Comando::IPRO){
+        Id id_procesador = com.consultar_id();
+        if (not c1.existe_procesador(id_procesador))
+        os << "ERROR: El procesador no existe" << endl;
+        else c1.imprimir_procesador(id_procesador, os);
+    }
+    else if (tipo == Comando::IPC){
+        c1.imprimir_procesador_cluster(os);
+    }
+    else if (tipo == Comando::IEC){
+        c1.imprimir_estructura_cluster(os);
+    }
+    else if (tipo == Comando::CMP){
+        Id id_procesador = com.consultar_id();
+        if (not c1.existe_procesador(id_procesador))
+        os << "ERROR: El procesador no existe" << endl;
+        else {
+            MARCADOR("compactar_memoria_procesador");
+            c1.compactar_memoria_procesador(id_procesador);
+        }
+    }
+    else if (tipo == Comando::CMC){
+        MARCADOR("compactar_memoria_cluster");
+        c1.compactar_memoria_cluster();
+    }
+    else if (tipo == Comando::MMP){
+        Id id_procesador = com.consultar_id();
+        const string &modelo = com.consultar_modelo();
+        if (not c1.existe_procesador(id_procesador))
+        os << "ERROR: El procesador no existe" << endl;
+        else if (modelo != "huecos" and modelo != "buddy" and modelo != "bitmap")
+        os << "ERROR: El modelo de memoria no existe" << endl;
+        else if (c1.procesador_ocupado(id_procesador))
+        os << "ERROR: El procesador tiene procesos en ejecucion" << endl;
+        else c1.modificar_modelo_memoria(id_procesador, modelo);
+    }
+    else if (tipo == Comando::IFP){
+        Id id_procesador = com.consultar_id();
+        if (not c1.existe_procesador(id_procesador))
+        os << "ERROR: El procesador no existe" << endl;
+        else os << c1.fragmentacion_interna_procesador(id_procesador) << endl;
+    }
+    else if (tipo == Comando::BPC){
+        int id_job = com.consultar_entero();
+        if (not c1.proceso_en_cluster(id_job))
+        os << "ERROR: El proceso no existe en el cluster" << endl;
+        else c1.imprimir_ubicacion_proceso(id_job, os);
+    }
+    else if (tipo == Comando::CDP){
+        Id id_procesador = com.consultar_id();
+        if (not c1.existe_procesador(id_procesador))
+        os << "ERROR: El procesador no existe" << endl;
+        else {
+            MARCADOR("compactar_deslizando");
+            os << c1.compactar_memoria_procesador(id_procesador, com.consultar_entero()) << endl;
+        }
+    }
+}
+
+void ejecutar_comando_area(Comando &com, Area_de_Espera &ae, ostream &os) {
+
+    Comando::Tipo tipo = com.consultar_tipo();
+
+    // Los procesos enviados por los productores entran antes de consultar la area de espera.
+    if (tipo != Comando::AP) ae.volcar_entradas(os);
+
+    if (entero_fuera_de_rango(com, os)) return;
+
+    if (tipo == Comando::AP){
+        Id id_prioridad = com.consultar_id();
+
+        if (ae.existe_prioridad(id_prioridad))
+        os << "ERROR: La prioridad ya existe" << endl;
+        else ae.alta_prioridad(id_prioridad);
+    }
+    else if (tipo == Comando::BP){
+        Id id_prioridad = com.consultar_id();
+
+        if (not ae.existe_prioridad(id_prioridad))
+        os << "ERROR: La prioridad no existe" << endl;
+        else if (ae.ocupado(id_prioridad))
+        os << "ERROR: La prioridad tiene procesos pendientes" << endl;
+        else ae.baja_prioridad(id_prioridad);
+    }
+    else if (tipo == Comando::APE){
+        Proceso job = com.extraer_proceso();
+        Id id_prioridad = com.consultar_id();
+
+        if (not ae.existe_prioridad(id_prioridad))
+        os << "ERROR: La prioridad no existe" << endl;
+        else if (ae.existe_proceso(id_prioridad, job.consultar_id()))
+        os << "ERROR: El proceso ya existe en la prioridad" << endl;
+        else ae.alta_proceso_espera(id_prioridad, std::move(job));
+    }
+    else if (tipo == Comando::IPRI){
+        Id id_prioridad = com.consultar_id();
+        if (not ae.existe_prioridad(id_prioridad))
+        os << "ERROR: La prioridad no existe" << endl;
+        else ae.imprimir_prioridad(id_prioridad, os);
+    }
+    else if (tipo == Comando::IAE){
+        ae.imprimir_area_espera(os);
+    }
+    else if (tipo == Comando::IMR){
+        os << "Memoria colas: " << ae.memoria_colas() << " bytes" << endl;
+        os << "Memoria residente: " << memoria_residente() << " KiB" << endl;
+    }
+}
+
+void ejecutar_comando(Comando &com, Cluster &c1, Area_de_Espera &ae, ostream &os) {
+
+    MARCADOR("ejecutar_comando");
+    Comando::Tipo tipo = com.consultar_tipo();
+
+    if (tipo == Comando::EPC){
+        if (not entero_fuera_de_rango(com, os)) {
+            MARCADOR("enviar_procesos_cluster");
+            ae.enviar_procesos_cluster(com.consultar_entero(), c1, os);
+        }
+    }
+    else if (tipo == Comando::SEPC){
+        ae.volcar_entradas(os);
+        if (not entero_fuera_de_rango(com, os)) {
+            int aceptados, rechazados;
+            ae.simular_envio(com.consultar_entero(), c1, aceptados, rechazados);
+            os << aceptados << ' ' << rechazados << endl;
+        }
+    }
+    else if (tipo == Comando::AP or tipo == Comando::BP or tipo == Comando::APE
+             or tipo == Comando::IPRI or tipo == Comando::IAE or tipo == Comando::IMR) {
+        ejecutar_comando_area(com, ae, os);
+    }
+    else ejecutar_comando_cluster(com, c1, os);
+}
+
+long memoria_residente() {
+    ifstream estado("/proc/self/status");
+    string campo;
+    while (estado >> campo) {
+        if (campo == "VmRSS:") {
+            long kib;
+            estado >> kib;
+            return kib;
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,66 @@
+/** @file Ejecutor.hh
+    @brief Ejecución de los comandos del simulador.
+
+    Todos los caminos que aplican comandos pasan por estas operaciones: el programa principal
+    (program.cc, en todos sus modos), las particiones y la area de espera del Despachador y el
+    ejecutor de Simulador_Async. Así las comprobaciones y los mensajes de error de cada comando
+    estan en un unico sitio.
+*/
+
+#ifndef EJECUTOR_HH
+#define EJECUTOR_HH
+
+#include "Cluster.hh"
+#include "Area_de_Espera.hh"
+#include "Comando.hh"
+
+#ifndef NO_DIAGRAM
+#include <iostream>
+using namespace std;
+#endif
+
+/** @brief Comprueba los enteros de un comando.
+    \pre <em>cierto</em>
+    \post El resultado indica si <em>com</em> es de tipo BPP, EPC, AT, BPC, SEPC o CDP y su
+    entero no cabe en el tipo que lo usa (Comando::entero_valido), o es de tipo APE, APP, CC o
+    MC y su proceso o su cluster tenia algun entero que no cabia (Comando::datos_validos); si
+    es así, se ha escrito en <em>os</em> "ERROR: Entero fuera de rango" y el comando no se
+    debe aplicar.
+*/
+bool entero_fuera_de_rango(const Comando &com, ostream &os);
+
+/** @brief Ejecuta un comando que solo usa el cluster.
+    \pre <em>com</em> es de tipo CC, MC, APP, BPP, AT, IPRO, IPC, IEC, CMP, CMC, MMP, IFP, BPC
+    o CDP.
+    \post Se ha aplicado <em>com</em> a <em>c1</em>, escribiendo en <em>os</em> su salida y los
+    mensajes de error correspondientes. El proceso o cluster de <em>com</em> se ha movido fuera
+    de él.
+*/
+void ejecutar_comando_cluster(Comando &com, Cluster &c1, ostream &os);
+
+/** @brief Ejecuta un comando que solo usa la area de espera.
+    \pre <em>com</em> es de tipo AP, BP, APE, IPRI, IAE o IMR.
+    \post Se ha aplicado <em>com</em> a <em>ae</em>, escribiendo en <em>os</em> su salida y los
+    mensajes de error correspondientes. Excepto con AP, antes se han volcado las entradas
+    concurrentes (Area_de_Espera::volcar_entradas). El proceso de <em>com</em> se ha movido
+    fuera de él.
+*/
+void ejecutar_comando_area(Comando &com, Area_de_Espera &ae, ostream &os);
+
+/** @brief Ejecuta un comando sobre un cluster y una area de espera.
+    \pre <em>com</em> no es de tipo FIN ni DESCONOCIDO.
+    \post Se ha aplicado <em>com</em> a <em>c1</em> y <em>ae</em>, escribiendo en <em>os</em>
+    su salida y los mensajes de error correspondientes: EPC y SEPC aqui mismo y los demás con
+    ejecutar_comando_cluster o ejecutar_comando_area. El proceso o cluster de <em>com</em> se
+    ha movido fuera de él.
+*/
+void ejecutar_comando(Comando &com, Cluster &c1, Area_de_Espera &ae, ostream &os);
+
+/** @brief Consulta la memoria residente del programa.
+    \pre <em>cierto</em>
+    \post El resultado es la memoria residente (VmRSS) del proceso en KiB, o -1 si el sistema
+    no la proporciona.
+*/
+long memoria_residente();
+
+#endif
@@ -0,0 +1,88 @@
+/** @file Identificadores.hh
+    @brief Especificación de la clase Identificadores.
+*/
+
+#ifndef IDENTIFICADORES_HH
+#define IDENTIFICADORES_HH
+
+#ifndef NO_DIAGRAM
+#include <string>
+#include <deque>
+#include <unordered_map>
+#include <shared_mutex>
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+using namespace std;
+#endif
+
+/** @brief Identificador interno de un procesador o una prioridad: un entero de 32 bits
+ *  denso (0, 1, 2, ...) asignado la primera vez que se lee su texto. */
+typedef uint32_t Id;
+
+/** @class Identificadores
+    @brief Tabla global que interna los identificadores de procesadores y prioridades. Cada
+    texto se convierte una sola vez, al leerlo, en un Id; a partir de ahí las estructuras del
+    cluster y de la area de espera se indexan por Id y solo se vuelve al texto para escribir
+    o para ordenar alfabeticamente.
+
+    Todas las operaciones se pueden llamar desde varios hilos a la vez: en el modo <em>-t</em>
+    el hilo lector interna los identificadores mientras el hilo ejecutor los escribe, y en el
+    modo <em>-p</em> el despachador interna mientras las particiones escriben. Las consultoras
+    y la busqueda de registrar toman el cerrojo en modo compartido, y registrar solo lo toma en
+    exclusiva para anadir un texto nuevo. Los textos no cambian de dirección al internar otros,
+    así que las referencias que devuelve nombre siguen siendo validas.
+*/
+class Identificadores {
+
+    public:
+
+    //Modificadora
+
+    /** @brief Modificadora que interna un identificador.
+     * \pre <em>cierto</em>
+     * \post El resultado es el Id asociado a <em>nombre</em>; si no tenia ninguno, se le
+     *  asigna el siguiente Id libre. Coste O(1) en media.
+    */
+    static Id registrar(const string &nombre);
+
+    //Consultoras
+
+    /** @brief Consultora del texto de un identificador.
+     * \pre <em>id</em> ha sido asignado por registrar.
+     * \post El resultado es el texto asociado a <em>id</em>, valido durante toda la ejecución
+     *  aunque otros hilos internen identificadores nuevos. Coste O(1).
+    */
+    static const string &nombre(Id id);
+
+    /** @brief Consultora del orden alfabetico de dos identificadores.
+     * \pre <em>a</em> y <em>b</em> han sido asignados por registrar.
+     * \post El resultado indica si el texto de <em>a</em> es menor que el de <em>b</em>.
+    */
+    static bool menor(Id a, Id b);
+
+    /** @brief Consultora del numero de identificadores internados.
+     * \pre <em>cierto</em>
+     * \post El resultado es el numero de Id asignados; todos son menores que él.
+    */
+    static Id tamano();
+
+
+    private:
+
+    /** @brief Texto de cada Id. Es una deque porque anadir al final no mueve los textos ya
+     *  guardados, a diferencia de un vector que se realoja. */
+    static deque<string> nombres;
+
+    /** @brief Id de cada texto. */
+    static unordered_map<string,Id> ids;
+
+    /** @brief Cerrojo de <em>nombres</em> e <em>ids</em>: exclusivo para registrar un texto
+     *  nuevo, compartido para consultar. */
+    static shared_mutex cerrojo;
+
+    /** @brief Numero de Id asignados, para consultarlo sin cerrojo. */
+    static atomic<Id> asignados;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,103 @@
+/** @file Lector.hh
+    @brief Especificación de la clase Lector.
+*/
+
+#ifndef LECTOR_HH
+#define LECTOR_HH
+
+#ifndef NO_DIAGRAM
+#include <string>
+#include <vector>
+#include <cstddef>
+using namespace std;
+#endif
+
+/** @class Lector
+    @brief Canal de entrada de texto del programa principal sin iostream. Si la entrada es un
+    fichero regular, se proyecta en memoria (mmap) con lectura secuencial anunciada al sistema
+    (madvise) y las palabras y enteros se analizan directamente sobre los bytes proyectados, sin
+    copiarlos a ningun buffer. Si es una tuberia o un terminal, se lee por bloques grandes con
+    read. En ambos casos las palabras son secuencias de caracteres sin espacios en blanco, como
+    con el operador >> de cin.
+*/
+class Lector {
+
+    public:
+
+    //Constructoras
+
+    /** @brief Creadora por defecto.
+     * \pre <em>cierto</em>
+     * \post El resultado es un lector cerrado.
+    */
+    Lector();
+
+    /** @brief Destructora.
+     * \pre <em>cierto</em>
+     * \post Se ha deshecho la proyección del fichero, si la habia.
+    */
+    ~Lector();
+
+    //Modificadoras
+
+    /** @brief Modificadora que abre un fichero como entrada.
+     * \pre El lector está cerrado.
+     * \post El resultado indica si se ha podido abrir <em>fichero</em>. Si se ha podido, el
+     *  lector queda abierto al principio del fichero.
+    */
+    bool abrir(const string &fichero);
+
+    /** @brief Modificadora que abre la entrada estandar como entrada.
+     * \pre El lector está cerrado.
+     * \post El lector queda abierto sobre la entrada estandar; si esta es un fichero regular
+     *  redirigido, también se proyecta en memoria.
+    */
+    void abrir_entrada_estandar();
+
+    /** @brief Modificadora que abre un texto en memoria como entrada.
+     * \pre El lector está cerrado. <em>texto</em> existe mientras el lector esté abierto.
+     * \post El lector queda abierto al principio de <em>texto</em>, sin copiarlo.
+    */
+    void abrir_texto(const string &texto);
+
+    /** @brief Operacion de lectura de una palabra.
+     * \pre El lector está abierto y quedan palabras por leer.
+     * \post El resultado es la siguiente palabra de la entrada.
+    */
+    string leer_palabra();
+
+    /** @brief Operacion de lectura de un entero.
+     * \pre El lector está abierto y la siguiente palabra es un entero.
+     * \post El resultado es el entero leido, analizado sin construir ningun string.
+    */
+    long long leer_entero();
+
+    //Consultora
+
+    /** @brief Consultora de fin de entrada.
+     * \pre El lector está abierto.
+     * \post El resultado indica si solo quedan espacios en blanco por leer.
+    */
+    bool fin();
+
+
+    private:
+
+    /** @brief Bytes de la entrada por leer: [actual, final). Apuntan a la proyección del
+     *  fichero o a <em>buffer</em>. */
+    const char *actual, *final;
+
+    /** @brief Proyección del fichero y su tamano; nullptr si la entrada no es un fichero
+     *  regular. */
+    void *proyeccion;
+    size_t tamano;
+
+    /** @brief Descriptor de la entrada, para rellenar <em>buffer</em> cuando no hay
+     *  proyección. */
+    int fd;
+
+    /** @brief Bloque leido de la entrada cuando no hay proyección. */
+    vector<char> buffer;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,107 @@
+/** @file Mapa_Bits.hh
+    @brief Especificación de la clase Mapa_Bits.
+*/
+
+#ifndef MAPA_BITS_HH
+#define MAPA_BITS_HH
+
+#ifndef NO_DIAGRAM
+#include <vector>
+#include <iostream>
+using namespace std;
+#endif
+
+#include "Tipos.hh"
+
+/** @class Mapa_Bits
+    @brief Mapa jerarquico de bits del espacio libre de la memoria de un procesador, pensado
+    para memorias de millones de posiciones. Cada palabra de 64 bits describe 64 posiciones
+    (bit a 1 = libre); cada nivel superior resume 64 palabras del nivel inferior y guarda el
+    hueco más largo que contiene. Las busquedas de huecos usan popcount y ctz sobre palabras
+    enteras y no dependen del numero de procesos. Marcar y liberar cuestan O(tamano/64) más la
+    altura de la jerarquia; el mejor ajuste no tiene una cota de ese tipo (ver mejor_ajuste).
+    Dispone de las operaciones necesarias para usarlo como representación del modelo de
+    memoria de mejor ajuste de un procesador.
+*/
+class Mapa_Bits {
+
+    public:
+
+    //Constructoras
+
+    /** @brief Creadora por defecto.
+     * \pre <em>cierto</em>
+     * \post El resultado es un mapa de bits vacio de tamano 0.
+    */
+    Mapa_Bits();
+
+    /** @brief Creadora con tamano.
+     * \pre <em>memoria</em> > 0
+     * \post El resultado es un mapa de <em>memoria</em> posiciones, todas libres.
+    */
+    Mapa_Bits(Tamano memoria);
+
+    //Modificadoras
+
+    /** @brief Modificadora que marca un intervalo como ocupado.
+     * \pre Las posiciones [<em>pos</em>, <em>pos</em>+<em>tamano</em>) están libres.
+     * \post Las posiciones del intervalo pasan a estar ocupadas y se han actualizado los
+     *  resumenes de los bloques afectados.
+    */
+    void ocupar(Tamano pos, Tamano tamano);
+
+    /** @brief Modificadora que marca un intervalo como libre.
+     * \pre Las posiciones [<em>pos</em>, <em>pos</em>+<em>tamano</em>) están ocupadas.
+     * \post Las posiciones del intervalo pasan a estar libres y se han actualizado los
+     *  resumenes de los bloques afectados.
+    */
+    void liberar(Tamano pos, Tamano tamano);
+
+    //Consultoras
+
+    /** @brief Consultora del hueco de mejor ajuste.
+     * \pre <em>tamano</em> > 0
+     * \post El resultado es la primera posición del hueco (intervalo maximal de posiciones
+     *  libres) más pequeno de tamano >= <em>tamano</em>; en caso de empate, el de posición
+     *  menor. Si no hay ninguno, el resultado es -1. Solo se visitan los bloques de 64
+     *  palabras cuyo hueco más largo es >= <em>tamano</em>, más las uniones entre bloques
+     *  vecinos (sufijo de uno y prefijo del siguiente). El mejor ajuste no se puede deducir
+     *  de los maximos de cada bloque, así que en el peor caso (muchos huecos grandes) el
+     *  coste es O(M/4096), siendo M el tamano de la memoria, y no O(altura).
+    */
+    Tamano mejor_ajuste(Tamano tamano) const;
+
+    /** @brief Consultora del tamano del hueco que empieza en una posición.
+     * \pre <em>pos</em> es la primera posición de un hueco.
+     * \post El resultado es el tamano de dicho hueco.
+    */
+    Tamano tamano_hueco(Tamano pos) const;
+
+    /** @brief Consultora del hueco más grande.
+     * \pre <em>cierto</em>
+     * \post El resultado es el tamano del hueco más grande del mapa. Coste O(1).
+    */
+    Tamano max_hueco() const;
+
+    /** @brief Consultora de la memoria libre.
+     * \pre <em>cierto</em>
+     * \post El resultado es el numero de posiciones libres del mapa.
+    */
+    Tamano memoria_libre() const;
+
+
+    private:
+
+    /** @brief Palabras de bits por nivel: <em>niveles[0]</em> tiene un bit por posición,
+     *  cada palabra del nivel k+1 tiene un bit por palabra no vacia del nivel k. */
+    vector< vector<unsigned long long> > niveles;
+
+    /** @brief Hueco más largo, libres al principio y libres al final de cada bloque de
+     *  64 palabras, para combinar huecos que cruzan bloques. */
+    vector<Tamano> max_bloque, prefijo_bloque, sufijo_bloque;
+
+    /** @brief Tamano de la memoria. */
+    Tamano memoria;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,79 @@
+/** @file Marcador.hh
+    @brief Especificación de la clase Marcador y de la macro MARCADOR.
+
+    Los marcadores solo existen si se compila con <em>-DPRO2_MARCADORES</em> (configuración
+    <em>profile</em> del Makefile); si no, MARCADOR no genera ningun código. Se marcan la
+    ejecución de cada comando (Ejecutor.cc) y sus fases caras, Cluster::alta_proceso (también
+    dentro de <em>epc</em>), los productores de <em>-e</em>, el reparto de comandos de
+    <em>-p</em> (Despachador) y los lotes de Simulador_Async (async.cc).
+*/
+
+#ifndef MARCADOR_HH
+#define MARCADOR_HH
+
+#ifndef NO_DIAGRAM
+#include <string>
+#include <chrono>
+using namespace std;
+#endif
+
+/** @class Marcador
+    @brief Marcador de ambito para perfilar las fases del simulador. Al crearse anota el
+    instante de inicio y al destruirse escribe un evento completo ("ph":"X") en formato Chrome
+    trace JSON, que se puede abrir con chrome://tracing, Perfetto o convertir a flamegraph.
+*/
+class Marcador {
+
+    public:
+
+    //Constructoras
+
+    /** @brief Creadora de un marcador.
+     * \pre <em>nombre</em> es una cadena constante que existe durante toda la ejecución.
+     * \post El resultado es un marcador de la fase <em>nombre</em> que empieza ahora.
+    */
+    Marcador(const char *nombre);
+
+    /** @brief Destructora.
+     * \pre <em>cierto</em>
+     * \post Si la traza de marcadores está abierta, se ha escrito en ella un evento con el
+     *  nombre, el hilo, el inicio y la duración del marcador.
+    */
+    ~Marcador();
+
+    //Modificadoras
+
+    /** @brief Modificadora que abre la traza de marcadores.
+     * \pre No hay ninguna traza de marcadores abierta.
+     * \post El resultado indica si se ha podido crear <em>fichero</em>. Si se ha podido, los
+     *  marcadores que terminen a partir de ahora se escriben en él, y la traza se cierra
+     *  automaticamente al terminar el programa.
+    */
+    static bool abrir_traza(const string &fichero);
+
+    /** @brief Modificadora que cierra la traza de marcadores.
+     * \pre <em>cierto</em>
+     * \post Se ha cerrado la lista de eventos JSON y el fichero.
+    */
+    static void cerrar_traza();
+
+
+    private:
+
+    /** @brief Nombre de la fase. */
+    const char *nombre;
+
+    /** @brief Instante de inicio. */
+    chrono::steady_clock::time_point inicio;
+};
+
+#ifdef PRO2_MARCADORES
+#define MARCADOR_CONCATENAR(a, b) a##b
+#define MARCADOR_VARIABLE(linea) MARCADOR_CONCATENAR(marcador_, linea)
+/** @brief Marca el resto del ambito actual como la fase <em>nombre</em>. */
+#define MARCADOR(nombre) Marcador MARCADOR_VARIABLE(__LINE__)(nombre)
+#else
+#define MARCADOR(nombre) do { } while (false)
+#endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,137 @@
+/** @file Memoria_Buddy.hh
+    @brief Especificación de la clase Memoria_Buddy.
+*/
+
+#ifndef MEMORIA_BUDDY_HH
+#define MEMORIA_BUDDY_HH
+
+#ifndef NO_DIAGRAM
+#include <vector>
+#include <map>
+#include <cstdint>
+#include <iostream>
+using namespace std;
+#endif
+
+#include "Tipos.hh"
+
+/** @class Memoria_Buddy
+    @brief Modelo de memoria de un procesador gestionado por el sistema buddy. La memoria
+    se divide en bloques de tamano potencia de dos; cada proceso ocupa el bloque más pequeno
+    donde cabe y los bloques libres se fusionan con su compañero ("buddy") al liberarse.
+    Dispone de operaciones para reservar y liberar bloques en tiempo logarítmico respecto al
+    tamano de la memoria, compactar, consultar el bloque libre más grande y la fragmentación
+    interna causada por el redondeo a potencias de dos.
+*/
+class Memoria_Buddy {
+
+    public:
+
+    //Constructoras
+
+    /** @brief Creadora por defecto.
+     * \pre <em>cierto</em>
+     * \post El resultado es una memoria buddy vacia de tamano 0.
+    */
+    Memoria_Buddy();
+
+    /** @brief Creadora con tamano.
+     * \pre <em>memoria</em> > 0
+     * \post El resultado es una memoria buddy libre de <em>memoria</em> posiciones. Si
+     *  <em>memoria</em> no es potencia de dos, las posiciones que sobrepasan la mayor potencia
+     *  de dos que no supera <em>memoria</em> se gestionan como bloques raiz adicionales: hay
+     *  una raiz por cada bit a 1 de <em>memoria</em>, de la más grande a la más pequena.
+    */
+    Memoria_Buddy(Tamano memoria);
+
+    //Modificadoras
+
+    /** @brief Modificadora que reserva un bloque para un proceso.
+     * \pre <em>tamano</em> > 0
+     * \post El resultado indica si se ha podido reservar un bloque de tamano la menor potencia
+     *  de dos >= <em>tamano</em>. Si se ha podido, <em>pos</em> es la primera posición del bloque
+     *  y se ha elegido el bloque libre más pequeno posible de cualquier raiz y, entre estos, el
+     *  de posición menor. Coste O(log M), siendo M el tamano de la memoria.
+    */
+    bool reservar(Tamano tamano, Tamano &pos);
+
+    /** @brief Modificadora que libera un bloque.
+     * \pre Existe un bloque reservado que empieza en la posición <em>pos</em>.
+     * \post Se ha liberado el bloque y fusionado con su compañero mientras este también esté
+     *  libre. Cada fusión es de coste constante, en total O(log M).
+    */
+    void liberar(Tamano pos);
+
+    /** @brief Modificadora que compacta la memoria buddy.
+     * \pre <em>cierto</em>
+     * \post Se han recolocado los bloques reservados por orden decreciente de tamano desde la
+     *  primera posición, de manera que todo el espacio libre queda fusionado en los bloques
+     *  más altos posibles. <em>traslados</em> contiene, para cada bloque movido, su posición
+     *  anterior y la nueva.
+    */
+    void compactar(map<Tamano,Tamano> &traslados);
+
+    //Consultoras
+
+    /** @brief Consultora del bloque libre más grande.
+     * \pre <em>cierto</em>
+     * \post El resultado es el tamano del bloque libre más grande de la memoria. Coste O(1).
+    */
+    Tamano max_bloque_libre() const;
+
+    /** @brief Consultora de la fragmentación interna.
+     * \pre <em>cierto</em>
+     * \post El resultado es la suma, para todos los bloques reservados, de la diferencia entre
+     *  el tamano del bloque y el tamano pedido al reservarlo.
+    */
+    Tamano fragmentacion_interna() const;
+
+
+    private:
+
+    /** @brief Estado de un bloque: libre, partido en sus dos mitades o reservado entero.
+     *  Cabe en 2 bits. */
+    enum Estado_Bloque { LIBRE, PARTIDO, RESERVADO };
+
+    /** @brief Menor orden de los nodos con <em>max_orden</em> guardado. */
+    static const int ORDEN_INDICE = 6;
+
+    /** @brief Arbol buddy de una raiz: el bloque de 2^<em>orden</em> posiciones que empieza en
+     *  <em>inicio</em>, como arbol binario completo en vectores (el nodo i tiene hijos 2i+1 y
+     *  2i+2). Ocupa unos 2 bits por nodo, es decir, medio byte por posición de memoria (8 MiB
+     *  para 2^24 posiciones). */
+    struct Raiz {
+        Tamano inicio;
+        int orden;
+        /** @brief Mapa de bits del arbol: el estado (Estado_Bloque) de cada nodo en 2 bits,
+         *  32 nodos por palabra; el nodo i ocupa los bits 2(i % 32) y 2(i % 32) + 1 de la
+         *  palabra i / 32. */
+        vector<uint64_t> estado;
+        /** @brief Orden (log2 del tamano) del bloque libre más grande bajo cada nodo de orden
+         *  >= ORDEN_INDICE, que son los primeros del arbol; -1 si no hay ninguno. Por debajo,
+         *  un subarbol tiene como mucho 127 nodos (4 palabras de <em>estado</em>) y su bloque
+         *  libre más grande se calcula recorriendolo, de manera que este indice solo ocupa un
+         *  byte por cada 64 posiciones y las operaciones siguen siendo O(log M). */
+        vector<signed char> max_orden;
+    };
+
+    /** @brief Raices de la memoria, una por cada bit a 1 de <em>memoria</em>, de la más
+     *  grande (que empieza en la posición 0) a la más pequena. Hay O(log M). */
+    vector<Raiz> raices;
+
+    /** @brief Tamano del bloque libre más grande de todas las raices. Se recalcula al final de
+     *  cada reserva, liberación y compactación mirando la raiz de cada arbol, O(log M), así
+     *  que max_bloque_libre es O(1). */
+    Tamano max_libre;
+
+    /** @brief Tamano pedido de cada bloque reservado, indexado por su posición inicial. */
+    map<Tamano,Tamano> pedido;
+
+    /** @brief Tamano de la memoria. */
+    Tamano memoria;
+
+    /** @brief Suma de las diferencias entre bloque reservado y tamano pedido. */
+    Tamano frag_interna;
+};
+
+#endif
\ No newline at end of file
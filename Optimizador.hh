@@ -0,0 +1,114 @@
+/** @file Optimizador.hh
+    @brief Especificación de la clase Optimizador.
+*/
+
+#ifndef OPTIMIZADOR_HH
+#define OPTIMIZADOR_HH
+
+#include "Comando.hh"
+#include "Cluster.hh"
+#include "Area_de_Espera.hh"
+#include "Identificadores.hh"
+
+#ifndef NO_DIAGRAM
+#include <queue>
+#include <vector>
+#endif
+
+/** @class Optimizador
+    @brief Etapa de optimización por mirilla entre la lectura y la ejecución de los comandos.
+    Recibe los comandos en el orden de entrada y entrega otra secuencia que produce la misma
+    salida y el mismo estado final:
+    - Varios <em>at</em> seguidos se fusionan en uno con la suma de los tiempos. Si la suma
+      no cabe en Tiempo (32 bits por defecto), antes de sumar el <em>at</em> que la desbordaria
+      se entrega uno con la suma acumulada y se empieza otra: avanzar t1 y despues t2 es lo
+      mismo que avanzar t1 + t2, así que los trozos producen la misma salida. Un <em>at</em>
+      con el entero fuera de rango (Comando::entero_valido) no se fusiona. Los comandos
+      que solo usan la area de espera (ap, bp, ape, ipri, iae) no consultan ni modifican el
+      cluster y pueden quedar entre ellos: se entregan antes del <em>at</em> fusionado.
+    - Un <em>cmp p</em> se descarta si la memoria de <em>p</em> no ha cambiado desde su ultima
+      compactación (por <em>cmp p</em> o <em>cmc</em>) y <em>p</em> existe; un <em>cmc</em>, si
+      no ha cambiado la memoria de ningun procesador desde el ultimo <em>cmc</em>. Compactar es
+      idempotente y en estos casos no se escribe nada. Cambian la memoria de un procesador
+      <em>app</em>, <em>bpp</em>, <em>mmp</em> y <em>cdp</em> sobre él (<em>cdp</em> compacta
+      solo en parte y nunca se descarta, porque escribe la memoria movida), <em>mc</em> sobre
+      él, que lo sustituye por otro cluster, y <em>at</em> y <em>epc</em> sobre todos, porque los
+      procesos que terminan abren huecos y los enviados ocupan memoria; <em>cc</em> cambia
+      todos los procesadores. Se consideran aplicados aunque terminen en error.
+    - Un <em>epc 0</em> se descarta si las entradas concurrentes de la area de espera están
+      vacias (Area_de_Espera::entradas_vacias): si no, vuelca los procesos de los productores y
+      escribe los repetidos. Dos <em>epc</em> seguidos no se fusionan en general: los procesos
+      rechazados por el primero vuelven a la area de espera y el segundo los vuelve a intentar,
+      cosa que un unico <em>epc</em> no haria.
+    Las decisiones que dependen del estado se toman en siguiente(), justo antes de ejecutar el
+    comando entregado, con el cluster y la area de espera ya actualizados por los comandos
+    anteriores; por eso siguiente() indica si el comando entregado se ha de ejecutar.
+*/
+class Optimizador {
+
+    public:
+
+    //Constructoras
+
+    /** @brief Creadora sobre un cluster y una area de espera.
+     * \pre <em>c</em> y <em>ae</em> existen mientras exista el optimizador y son el cluster y
+     *  la area de espera donde se ejecutan los comandos entregados.
+     * \post El resultado es un optimizador sin comandos pendientes.
+    */
+    Optimizador(const Cluster &c, const Area_de_Espera &ae);
+
+    //Modificadoras
+
+    /** @brief Modificadora que anade el siguiente comando de la entrada.
+     * \pre <em>com</em> no es de tipo FIN ni DESCONOCIDO.
+     * \post <em>com</em> se ha movido al optimizador.
+    */
+    void anadir(Comando &&com);
+
+    /** @brief Modificadora que indica el final de la entrada.
+     * \pre <em>cierto</em>
+     * \post Todos los comandos pendientes pasan a estar listos para entregar.
+    */
+    void vaciar();
+
+    /** @brief Modificadora que entrega el siguiente comando listo.
+     * \pre hay_listo()
+     * \post Se ha movido a <em>com</em> el siguiente comando listo y se ha eliminado del
+     *  optimizador. El resultado indica si se ha de ejecutar; es falso si el comando es un
+     *  <em>cmp</em>, <em>cmc</em> o <em>epc 0</em> que se descarta en el estado actual, y
+     *  entonces no se ejecuta. Si es cierto, <em>com</em> no es de tipo FIN ni DESCONOCIDO y
+     *  se debe ejecutar antes de volver a llamar a siguiente().
+    */
+    bool siguiente(Comando &com);
+
+    //Consultora
+
+    /** @brief Consultora que indica si hay algun comando listo para entregar.
+     * \pre <em>cierto</em>
+     * \post El resultado indica si se puede llamar a siguiente() sin perder ninguna
+     *  optimización con los comandos que aun no se han anadido.
+    */
+    bool hay_listo() const;
+
+
+    private:
+
+    /** @brief Cluster y area de espera donde se ejecutan los comandos entregados. */
+    const Cluster *c;
+    const Area_de_Espera *ae;
+
+    /** @brief Comandos listos para entregar, en orden. */
+    queue<Comando> listos;
+
+    /** @brief Suma de los <em>at</em> pendientes de fusionar; 0 si no hay ninguno. Nunca
+     *  supera numeric_limits<Tiempo>::max(), ver la fusión de <em>at</em>. */
+    Tiempo tiempo_pendiente;
+
+    /** @brief Indica, por Id, si la memoria del procesador está compactada y no ha cambiado. */
+    vector<bool> compactado;
+
+    /** @brief Indica si la memoria de todos los procesadores está compactada y no ha cambiado. */
+    bool cluster_compactado;
+};
+
+#endif
\ No newline at end of file
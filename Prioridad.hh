@@ -6,6 +6,16 @@
 #define PRIORIDAD_HH
 
 #include "Proceso.hh"
+#include "Identificadores.hh"
+#include "Cola_MPSC.hh"
+
+#ifndef NO_DIAGRAM
+#include <memory>
+#include <utility>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#endif
 
 /** @class Prioridad
  *  @brief Esta clase hace referencia a una prioridad, un contenedor de procesos con una 
@@ -27,7 +37,29 @@ class Prioridad {
     * \post El resultado es una prioridad identificado como el parametro <em>id_prioridad</em>
     *  sin procesos.
     */
-    Prioridad (string id_prioridad);
+    Prioridad (Id id_prioridad);
+
+    /** @brief Creadora copiadora.
+    * \pre Ningun hilo vuelca la entrada concurrente de <em>otra</em> durante la copia.
+    * \post El resultado es una prioridad con el identificador, los contadores y los procesos
+    * en espera de <em>otra</em>, en el mismo orden, y con su propia entrada concurrente vacia:
+    * los procesos de la entrada de <em>otra</em> que aun no se han volcado no se copian. Las
+    * dos prioridades no comparten nada.
+    */
+    Prioridad (const Prioridad &otra);
+
+    /** @brief Creadora por movimiento.
+    * \pre Ningun hilo anade procesos a la entrada concurrente de <em>otra</em> durante la
+    * llamada.
+    * \post El resultado tiene el estado de <em>otra</em>, incluida su entrada concurrente;
+    * <em>otra</em> queda en un estado valido pero no especificado.
+    */
+    Prioridad (Prioridad &&otra) noexcept;
+
+    /** @brief Asignaciones, con el mismo criterio que las creadoras copiadora y por
+    * movimiento. */
+    Prioridad &operator= (const Prioridad &otra);
+    Prioridad &operator= (Prioridad &&otra) noexcept;
 
     // Modificadora
 
@@ -37,6 +69,13 @@ class Prioridad {
     */
     void alta_proceso_prioridad (const Proceso &job);
 
+    /** @brief Modificadora que anade un proceso a la prioridad moviendolo, sin copiarlo.
+    * \pre <em>cierto</em>
+    * \post El resultado es la prioridad original con un proceso nuevo <em>job</em>;
+    * <em>job</em> queda en un estado valido pero no especificado.
+    */
+    void alta_proceso_prioridad (Proceso &&job);
+
     /** @brief Modificadora que actualiza los procesos aceptados y rechazados en una prioridad.
     * \pre <em>aceptados</em> >= 0, <em>rechazados</em> >= 0
     * \post Se ha actualizado la cantidad de procesos aceptados y la cantidad de procesos rechazados.
@@ -49,40 +88,101 @@ class Prioridad {
     */
     void baja_mas_antiguo();
 
+    /** @brief Modificadora que extrae el proceso mas antiguo.
+    * \pre Existe al menos un proceso en la prioridad del parametro implicito.
+    * \post El resultado es el proceso más antiguo de la prioridad del parametro implicito,
+    * movido fuera de ella, y se ha eliminado de la prioridad. Equivale a consulta_mas_antiguo
+    * seguido de baja_mas_antiguo sin copiar el proceso.
+    */
+    Proceso extraer_mas_antiguo();
+
+    /** @brief Modificadora que anade un proceso a la entrada concurrente de la prioridad.
+    * \pre Puede llamarla cualquier hilo, concurrentemente con otras llamadas a esta operacion
+    * y con volcar_entrada.
+    * \post El resultado indica si habia sitio en la entrada. Si lo habia, <em>job</em> se ha
+    * movido a la entrada; no forma parte de la prioridad hasta que se vuelca. El orden de
+    * antiguedad de los procesos anadidos así es el orden en que reservan su casilla de la
+    * entrada (el incremento atomico de Cola_MPSC::encolar), que es el punto en que la llamada
+    * tiene efecto: un proceso anadido por una llamada que termina antes de que empiece otra
+    * es más antiguo que el de la otra.
+    */
+    bool alta_proceso_concurrente (Proceso &&job);
+
+    /** @brief Modificadora que pasa los procesos de la entrada concurrente a la prioridad.
+    * \pre Solo la llama un hilo a la vez.
+    * \post Se han anadido a la prioridad, por orden de casilla, los procesos de la entrada
+    * hasta la primera casilla reservada pero aun no publicada: esa casilla y las siguientes
+    * quedan para el siguiente volcado, de manera que un proceso nunca pasa por delante de otro
+    * más antiguo. Los procesos con el mismo identificador que un proceso ya pendiente (o que
+    * otro volcado antes) no se anaden: sus identificadores se han anadido, en orden, al final
+    * de <em>repetidos</em>.
+    */
+    void volcar_entrada (vector<int> &repetidos);
+
     // Consultoras
 
+    /** @brief Consultora que indica si la entrada concurrente está vacia.
+    * \pre Solo la llama el hilo que llama a volcar_entrada.
+    * \post El resultado indica si la entrada concurrente de la prioridad del parametro
+    * implicito estaba vacia en algun momento durante la llamada (Cola_MPSC::vacia).
+    */
+    bool entrada_vacia () const;
+
     /** @brief Consultora del proceso mas antiguo de una prioridad.
     * \pre Existe al menos un proceso en la prioridad del parametro implicito.
     * \post El resultado es el proceso más antiguo de la prioridad del parametro implicito.
     */
-    Proceso consulta_mas_antiguo();
+    const Proceso &consulta_mas_antiguo() const;
 
     /** @brief Consultora de procesos aceptados.
     * \pre <em>cierto</em>
     * \post El resultado es la cantidad de procesos aceptados de la prioridad del parametro
-    * implicito.
+    * implicito. Coste O(1).
     */
     int consultar_aceptados () const;
 
     /** @brief Consultora de procesos rechazados de una prioridad
     * \pre <em>cierto</em>
     * \post El resultado es la cantidad de procesos rechazados de la prioridad del parametro
-    * implicito.
+    * implicito. Coste O(1).
     */
     int consultar_rechazados () const;
 
     /** @brief Consultora del numero de procesos de una prioridad.
     * \pre <em>cierto</em>
     * \post El resultado es la cantidad de procesos en espera en la prioridad del parametro implicito.
+    * Coste O(1).
     */
     int tamano () const;
 
+    /** @brief Consultora de la menor memoria requerida por un proceso pendiente.
+    * \pre Existe al menos un proceso en la prioridad del parametro implicito.
+    * \post El resultado es la menor memoria requerida por los procesos en espera en la
+    * prioridad del parametro implicito. Coste O(1).
+    */
+    Tamano min_tamano_pendiente () const;
+
+    /** @brief Consultora del numero de procesos pendientes que caben en una memoria.
+    * \pre <em>cierto</em>
+    * \post El resultado es el numero de procesos en espera en la prioridad del parametro
+    * implicito que requieren <em>s</em> o menos memoria. Coste O(log n).
+    */
+    int pendientes_hasta (Tamano s) const;
+
+    /** @brief Consultora de la memoria ocupada por la cola de la prioridad.
+    * \pre <em>cierto</em>
+    * \post El resultado es el numero de bytes reservados por la cola de procesos en espera de
+    * la prioridad del parametro implicito, incluidos los bloques sin llenar, más los del indice
+    * por tamano (sus bloques de claves y el arbol de cuentas).
+    */
+    size_t memoria_cola () const;
+
     /** @brief Consultora de existencia de un proceso.
      * \pre <em>cierto</em>
      * \post El resultado indica si existe un proceso con identificador <em>id_proceso</em>
      *  en la prioridad del parametro implicito.
     */
-    bool existe_proceso (string id_proceso) const;
+    bool existe_proceso (int id_proceso) const;
 
     //Escriptura
 
@@ -94,9 +194,66 @@ class Prioridad {
     */
     void imprimir_procesos () const;
 
+    /** @brief Operacion de escriptura en un canal.
+    * \pre Las mismas que imprimir_procesos().
+    * \post Se escribe en <em>os</em> lo mismo que imprimir_procesos() escribe en el canal de salida.
+    */
+    void imprimir_procesos (ostream &os) const;
+
 
     private:
 
+    /** @brief Procesos aceptados, rechazados y en espera, mantenidos en cada operacion. */
+    int aceptados, rechazados, pendientes;
+
+    /** @brief Numero de procesos de un bloque de la cola. */
+    static const int PROCESOS_BLOQUE = 4096;
+
+    /** @brief Bloque de la cola: procesos empaquetados de 12 bytes, alineado a linea de cache
+     *  (48 KiB por bloque). Se reserva con new, que solo respeta alignas(64) desde C++17. */
+    static_assert(__cplusplus >= 201703L, "Prioridad requiere C++17 o posterior (new alineado)");
+    struct alignas(64) Bloque {
+        Proceso procesos[PROCESOS_BLOQUE];
+    };
+
+    /** @brief Cola por antiguedad de los procesos en espera: buffer circular de bloques que
+     *  crece de bloque en bloque. El proceso de posición global i está en el bloque
+     *  (i / PROCESOS_BLOQUE) % bloques.size(). Sin nodos ni punteros por proceso. */
+    vector< unique_ptr<Bloque> > bloques;
+
+    /** @brief Posiciones globales del proceso más antiguo y de la siguiente a la del más
+     *  nuevo. */
+    size_t primero, ultimo;
+
+    /** @brief Numero maximo de claves de un bloque del indice por tamano. */
+    static const int CLAVES_BLOQUE = 1024;
+
+    /** @brief Clave del indice por tamano: memoria requerida e identificador de un proceso
+     *  en espera, 8 bytes (16 con 64 bits), sin relleno. */
+    struct Clave {
+        Tamano tamano;
+        int32_t id;
+    };
+    static_assert(sizeof(Clave) == 2 * sizeof(Tamano), "Clave no debe tener más relleno");
+
+    /** @brief Indice de los procesos en espera por (memoria requerida, identificador),
+     *  empaquetado como la cola: bloques de claves ordenados entre ellos y por dentro, cada
+     *  uno con como mucho CLAVES_BLOQUE claves, sin ningun nodo por proceso. Una alta o una
+     *  baja busca su bloque por la primera clave (O(log n)) y desplaza las claves del bloque
+     *  (O(CLAVES_BLOQUE)); un bloque lleno se parte y uno que queda a menos de la mitad se une
+     *  con su vecino. min_tamano_pendiente es la primera clave, O(1). */
+    vector< vector<Clave> > por_tamano;
+
+    /** @brief Arbol de Fenwick con el numero de claves de cada bloque de <em>por_tamano</em>:
+     *  pendientes_hasta busca el bloque, suma los anteriores y busca dentro del bloque, en
+     *  O(log n). Se reconstruye al partir o unir bloques, O(n / CLAVES_BLOQUE), como mucho
+     *  una vez por cada CLAVES_BLOQUE / 2 altas o bajas. */
+    vector<int> cuentas;
+
+    /** @brief Entrada concurrente: procesos pendientes de volcar, en orden de casilla. Se
+     *  guarda por puntero porque una Cola_MPSC no se puede copiar ni mover; cada prioridad
+     *  tiene la suya (ver la creadora copiadora). */
+    unique_ptr< Cola_MPSC<Proceso> > entrada;
 };
 
 #endif
\ No newline at end of file
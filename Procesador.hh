@@ -6,6 +6,16 @@
 #define PROCESADOR_HH
 
 #include "Proceso.hh"
+#include "Memoria_Buddy.hh"
+#include "Mapa_Bits.hh"
+#include "Identificadores.hh"
+
+#ifndef NO_DIAGRAM
+#include <vector>
+#include <map>
+#include <set>
+#include <unordered_map>
+#endif
 
 /** @class Procesador
     @brief Clase de procesador, hace referencia a un procesador que puede ejercutar procesos.
@@ -14,6 +24,10 @@
     un procesador está ocupado, la memoria disponible y la existencia de un proceso. Por ultimo,
     tiene operaciones de lectura y escriptura para leer los datos de un procesador y escribir
     los procesos de estos.
+
+    Compilado con <em>-DPRO2_REFERENCIA</em>, los modelos "huecos" y "bitmap" guardan solo la
+    lista de procesos por posición y buscan el hueco más ajustado recorriendola entera en cada
+    alta, sin ningun indice de huecos.
 */
 class Procesador {
 
@@ -34,10 +48,19 @@ class Procesador {
      * \pre Hay memoria suficiente para que el proceso quepa.
      * \post El resultado indica si se ha podido anadir el proceso en el procesador, si se
      *  ha podido, el procesador original tendrá un nuevo proceso <em>job</em> en la posición
-     *  de memoria donde quede más ajustado.
+     *  de memoria donde quede más ajustado. Con el modelo "buddy", el proceso ocupa el bloque
+     *  potencia de dos más pequeno donde cabe.
     */
     bool alta_proceso_procesador (const Proceso &job);
 
+    /** @brief Modificadora que anade un proceso a un procesador moviendolo, sin copiarlo.
+     * \pre <em>cierto</em>
+     * \post El resultado indica si se ha podido anadir el proceso, con el mismo criterio que la
+     *  version con <em>const Proceso &</em>. Si se ha podido, <em>job</em> queda en un estado
+     *  valido pero no especificado; si no, <em>job</em> no se ha modificado.
+    */
+    bool alta_proceso_procesador (Proceso &&job);
+
     /** @brief Modificadora que elimina un proceso de un procesador.
      * \pre Existe un proceso identificado como el parametro <em>id_job</em> en procesador
      *  del parametro implicito. 
@@ -45,19 +68,63 @@ class Procesador {
     */
     void baja_proceso_procesador (int id_job);
 
+    /** @brief Modificadora que elimina varios procesos de un procesador a la vez.
+     * \pre Los identificadores de <em>ids_job</em> son distintos y hay un proceso con cada uno
+     *  en el procesador del parametro implicito.
+     * \post Se han eliminado los procesos <em>ids_job</em> del procesador del parametro
+     *  implicito, con el mismo resultado que eliminarlos uno a uno. Los procesos se ordenan
+     *  por posición y los tramos libres que resultan (cada proceso con los huecos y procesos
+     *  eliminados contiguos) se calculan en una sola pasada, así que el indice de huecos se
+     *  actualiza una vez por tramo y no una vez por proceso. Con el modelo "bitmap" se libera
+     *  cada tramo de una vez; con "buddy" se libera cada bloque.
+    */
+    void baja_procesos_procesador (const vector<int> &ids_job);
+
     /** @brief Modificadora que compacta la memoria de un procesador. 
      * \pre <em>cierto</em>
      * \post Se han colocado todos los procesos del procesador del parametro implicito al 
-     * principio de la memoria, sin dejar huecos, ni solaparse entre ellos.
+     * principio de la memoria, sin dejar huecos, ni solaparse entre ellos. Con el modelo
+     * "buddy", los bloques se colocan por orden decreciente de tamano.
     */
     void compactar_memoria_procesador ();
 
+    /** @brief Modificadora que compacta la memoria de un procesador solo hasta conseguir un
+     *  hueco de un tamano.
+     * \pre <em>objetivo</em> >= 0
+     * \post Se han deslizado hacia el principio de la memoria, por orden de posición y sin
+     *  dejar huecos entre ellos, los procesos situados despues del primer hueco, parando en
+     *  cuanto el hueco que dejan detrás (junto con el hueco siguiente) mide al menos
+     *  <em>objetivo</em>, o al llegar al último proceso. Los procesos anteriores al primer hueco
+     *  y los posteriores al punto de parada no se mueven; si ya hay un hueco de
+     *  <em>objetivo</em> posiciones, no se mueve nada. El resultado es la suma de los tamanos
+     *  de los procesos movidos. Con el modelo "buddy" se compacta toda la memoria como en
+     *  compactar_memoria_procesador().
+    */
+    Tamano compactar_deslizando (Tamano objetivo);
+
+    /** @brief Modificadora que cambia el modelo de gestión de memoria de un procesador.
+     * \pre El procesador del parametro implicito no tiene procesos en ejecucion.
+     *  <em>modelo</em> es "huecos", "buddy" o "bitmap".
+     * \post La memoria del procesador del parametro implicito pasa a gestionarse con el
+     *  modelo indicado: "huecos" es el modelo por defecto (el hueco más ajustado de entre
+     *  todos los huecos), "buddy" divide la memoria en bloques potencia de dos y "bitmap"
+     *  sigue el mismo criterio que "huecos" representando el espacio libre con un mapa
+     *  jerarquico de bits, adecuado para memorias muy grandes.
+    */
+    void modificar_modelo_memoria (const string &modelo);
+
     /** @brief Modificadora que avanza <em>t</em> unidades de tiempo del procesador del 
      * parametro implicito.
      * \pre t >= 0
-     * \post Se ha añadido t unidades de tiempo al procesador del parametro implicito.
+     * \post Se ha añadido t unidades de tiempo al procesador del parametro implicito. Los
+     *  procesos guardan el instante en que terminan respecto al reloj del procesador, de 64
+     *  bits como el del cluster porque acumula todos los avances y con Tiempo de 32 bits se
+     *  desbordaria; el tiempo restante de un proceso cabe siempre en Tiempo. Así que si
+     *  <em>t</em> < proxima_finalizacion() solo se avanza el reloj, con coste O(1); si no,
+     *  se eliminan con baja_procesos_procesador todos los procesos que terminan en las
+     *  <em>t</em> unidades.
     */
-    void avanzar_tiempo_procesador (int t);
+    void avanzar_tiempo_procesador (Tiempo t);
 
     //Consultora
 
@@ -73,22 +140,45 @@ class Procesador {
      * \post El resultado indica si existe un proceso identificado como <em>id_proceso</em>
      *  en el procesador del parametro implicito.
     */
-    bool existe_proceso(string id_proceso) const;
+    bool existe_proceso(int id_proceso) const;
+
+    /** @brief Consultora del tiempo que falta para que termine el primer proceso.
+     * \pre <em>cierto</em>
+     * \post El resultado es el menor tiempo restante de los procesos del procesador del
+     *  parametro implicito; numeric_limits<Tiempo>::max() si no tiene procesos. Coste O(1).
+    */
+    Tiempo proxima_finalizacion() const;
 
     /** @brief Consultora del tamaño del hueco más grande en la memoria de un procesador.
      * \pre <em>cierto</em>
      * \post El resultado indica el tamano del hueco más grande en el procesador del 
-     * parametro implicito.
+     * parametro implicito. Con el modelo "buddy", es el tamano del bloque libre más grande.
+    */
+    Tamano max_espacio_actual() const;
+
+    /** @brief Consultora de la fragmentación interna de la memoria de un procesador.
+     * \pre <em>cierto</em>
+     * \post El resultado es la memoria reservada y no pedida por los procesos del procesador
+     *  del parametro implicito por el redondeo a potencias de dos del modelo "buddy". Con el
+     *  modelo "huecos" el resultado es 0.
     */
-    int max_espacio_actual() const;
+    Tamano fragmentacion_interna() const;
     
     //Lectura y escriptura
 
     /** @brief Operacion de lectura del procesador.
      * \pre Hay en el canal de entrada el identificador del procesador y el tamano de memoria de este.
      * \post El procesador del parametro implicito pasa a tener el identificador y tamano especificado.
+     *  El identificador queda internado en Identificadores. El resultado indica si el tamano
+     *  leido cabe en Tamano y es positivo; si no, el procesador no se debe usar.
     */
-    void configurar_procesador ();
+    bool configurar_procesador ();
+
+    /** @brief Operacion de lectura del procesador desde un Lector.
+     * \pre Hay en <em>entrada</em> el identificador del procesador y el tamano de memoria de este.
+     * \post Lo mismo que configurar_procesador().
+    */
+    bool configurar_procesador (Lector &entrada);
 
     /** @brief Operacion de escriptura de los procesos.
      * \pre <em>cierto</em>
@@ -98,8 +188,66 @@ class Procesador {
     */
     void imprimir_procesos() const;
 
+    /** @brief Operacion de escriptura en un canal.
+     * \pre Las mismas que imprimir_procesos().
+     * \post Se escribe en <em>os</em> lo mismo que imprimir_procesos() escribe en el canal de salida.
+    */
+    void imprimir_procesos(ostream &os) const;
+
+    /** @brief Operacion de escriptura de los procesos con el reloj adelantado.
+     * \pre 0 <= <em>retraso</em> < proxima_finalizacion()
+     * \post Se escribe lo mismo que escribiria imprimir_procesos() despues de
+     *  avanzar_tiempo_procesador(<em>retraso</em>), sin modificar el procesador. Lo usa el
+     *  cluster para los procesadores que aun no ha avanzado hasta su reloj.
+    */
+    void imprimir_procesos(Tiempo retraso) const;
+
+    /** @brief Operacion de escriptura en un canal.
+     * \pre Las mismas que imprimir_procesos(<em>retraso</em>).
+     * \post Se escribe en <em>os</em> lo mismo que imprimir_procesos(<em>retraso</em>) escribe en el canal de salida.
+    */
+    void imprimir_procesos(Tiempo retraso, ostream &os) const;
+
 
     private:
 
+    /** @brief Identificador del procesador. */
+    Id id;
+
+    /** @brief Tamano de la memoria del procesador. */
+    Tamano memoria;
+
+    /** @brief Procesos en ejecución por posición inicial de memoria, en el orden en que se
+     *  escriben. El tiempo de cada proceso no se actualiza al avanzar el reloj: lo que le
+     *  falta se obtiene de <em>finalizaciones</em>. */
+    map<Tamano, Proceso> procesos;
+
+    /** @brief Posición de cada proceso en ejecución, por identificador. */
+    unordered_map<int, Tamano> posiciones;
+
+    /** @brief Instante de fin de cada proceso respecto a <em>reloj</em> y su identificador,
+     *  ordenados: el primero da proxima_finalizacion() en O(1) y avanzar_tiempo_procesador
+     *  recoge de aqui los procesos que terminan. */
+    set< pair<long long, int> > finalizaciones;
+
+    /** @brief Indice de huecos del modelo "huecos": (tamano, posición) de cada hueco, de
+     *  manera que el hueco más ajustado es un lower_bound y el ultimo elemento es
+     *  max_espacio_actual(). Los huecos vecinos de un proceso se obtienen de
+     *  <em>procesos</em>. Vacio con los otros modelos y en el motor de referencia. */
+    set< pair<Tamano, Tamano> > huecos;
+
+    /** @brief Modelo de gestión de memoria del procesador. */
+    enum Modelo { HUECOS, BUDDY, BITMAP };
+    Modelo modelo;
+
+    /** @brief Memoria del modelo "buddy"; vacia con los otros modelos. */
+    Memoria_Buddy buddy;
+
+    /** @brief Espacio libre del modelo "bitmap"; vacio con los otros modelos. */
+    Mapa_Bits mapa;
+
+    /** @brief Reloj del procesador: suma de todos los avances de tiempo. Los instantes de
+        fin de los procesos son también long long. */
+    long long reloj;
 };
 #endif
\ No newline at end of file
@@ -7,9 +7,13 @@
 
 #ifndef NO_DIAGRAM
 #include <iostream>
+#include <cstdint>
 using namespace std;
 #endif
 
+#include "Lector.hh"
+#include "Tipos.hh"
+
 /** @class Proceso
     @brief Clase de proceso, hace referencia a tareas que tienen un identificador, memoria
     requierida y tiempo de ejecución. Dispone de operaciones para consultar cada datos de
@@ -27,13 +31,20 @@ class Proceso {
     */
     Proceso();
 
+    /** @brief Creadora con datos.
+    * \pre <em>tamano</em> > 0, <em>tiempo</em> > 0
+    * \post El resultado es un proceso con identificador <em>id</em>, memoria requerida
+    * <em>tamano</em> y tiempo de ejecución <em>tiempo</em>.
+    */
+    Proceso(int id, Tamano tamano, Tiempo tiempo);
+
     //Modificadora
 
     /** @brief Modificadora que actualiza el estado del proceso.
     * \pre <em>t_procesador</em> >= 0
     * \post El resultado indica si el proceso ha terminado.
     */
-    bool actualizar_proceso(int t_procesador);
+    bool actualizar_proceso(Tiempo t_procesador);
 
     //Consultoras
 
@@ -47,22 +58,32 @@ class Proceso {
      * \pre El proceso del parametro implicito tiene tiempo de ejecución especificado.
      * \post El resultado es el tiempo de ejecucion del proceso del parametro implicito.
     */
-    int consultar_tiempo () const;
+    Tiempo consultar_tiempo () const;
 
     /** @brief Consultora de tamano de un proceso.
      * \pre El proceso del parametro implicito tiene memoria requierida especificado.
      * \post El resultado es la memoria requerida del proceso del parametro implicito.
     */
-    int consultar_tamano () const;
+    Tamano consultar_tamano () const;
 
     //Lectura y escriptura
 
     /** @brief Operacion de lectura de un proceso.
      * \pre Hay en el canal de entrada el identificador del proceso, memoria que ocupa y 
      *  el tiempo de ejecucion.
-     * \post El proceso del parametro implicito pasa a tener los datos especificados.
+     * \post El resultado indica si los datos leidos caben en sus campos: el identificador en
+     *  32 bits y la memoria y el tiempo en Tamano y Tiempo, sin ser negativos. Si caben, el
+     *  proceso del parametro implicito pasa a tener los datos especificados; si no, no se debe
+     *  usar, porque convertirlos los truncaria (4294967297 seria el proceso 1).
+    */
+    bool leer();
+
+    /** @brief Operacion de lectura de un proceso desde un Lector.
+     * \pre Hay en <em>entrada</em> el identificador del proceso, memoria que ocupa y el
+     *  tiempo de ejecucion.
+     * \post Lo mismo que leer().
     */
-    void leer();
+    bool leer(Lector &entrada);
 
     /** @brief Operacion de escriptura de un proceso.
      * \pre <em>cierto</em>
@@ -71,9 +92,23 @@ class Proceso {
     */
     void imprimir() const;
 
+    /** @brief Operacion de escriptura en un canal.
+     * \pre Las mismas que imprimir().
+     * \post Se escribe en <em>os</em> lo mismo que imprimir() escribe en el canal de salida.
+    */
+    void imprimir(ostream &os) const;
+
 
     private:
-    
+
+    /** @brief Identificador, memoria requerida y tiempo de ejecución restante, con anchura
+     *  fija para que un proceso ocupe 12 bytes en las colas de espera (24 con 64 bits). */
+    int32_t id;
+    Tamano tamano;
+    Tiempo tiempo;
 };
 
+static_assert(sizeof(Proceso) == (sizeof(Tamano) == 4 ? 12 : 24),
+              "Proceso no debe tener relleno innecesario");
+
 #endif
\ No newline at end of file
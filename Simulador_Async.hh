@@ -0,0 +1,197 @@
+/** @file Simulador_Async.hh
+    @brief Especificación de la clase Simulador_Async. Requiere C++20 (corrutinas), el estandar
+    con que el Makefile compila todo el arbol.
+*/
+
+#ifndef SIMULADOR_ASYNC_HH
+#define SIMULADOR_ASYNC_HH
+
+#include "Cluster.hh"
+#include "Area_de_Espera.hh"
+#include "Comando.hh"
+#include "Ejecutor.hh"
+
+#ifndef NO_DIAGRAM
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+#endif
+
+/** @class Tarea
+    @brief Tipo de retorno de las corrutinas que usan el simulador: una corrutina que devuelve
+    Tarea empieza a ejecutarse al llamarla y se suspende en cada co_await de una Operacion
+    hasta que el ejecutor la completa.
+*/
+class Tarea {
+
+    public:
+
+    /** @brief Promesa de la corrutina, requerida por el lenguaje. */
+    struct promise_type {
+        Tarea get_return_object();
+        std::suspend_never initial_suspend() noexcept;
+        std::suspend_always final_suspend() noexcept;
+        void return_void();
+        void unhandled_exception();
+    };
+
+    /** @brief Creadora por movimiento.
+     * \pre <em>cierto</em>
+     * \post El resultado tiene la corrutina de <em>otra</em>, que queda sin corrutina.
+    */
+    Tarea(Tarea &&otra) noexcept;
+
+    /** @brief Asignación por movimiento.
+     * \pre <em>cierto</em>
+     * \post Se ha destruido la corrutina del parametro implicito, si tenia, y ha pasado a tener
+     *  la de <em>otra</em>, que queda sin corrutina.
+    */
+    Tarea &operator=(Tarea &&otra) noexcept;
+
+    /** @brief Una tarea es la unica propietaria de su corrutina: no se puede copiar. */
+    Tarea(const Tarea &) = delete;
+    Tarea &operator=(const Tarea &) = delete;
+
+    /** @brief Consultora que indica si la corrutina ha terminado.
+     * \pre <em>cierto</em>
+     * \post El resultado indica si la corrutina de la tarea ha llegado al final.
+    */
+    bool terminada() const;
+
+    /** @brief Destructora.
+     * \pre <em>cierto</em>
+     * \post Se ha destruido el estado de la corrutina, si la tarea tiene.
+    */
+    ~Tarea();
+
+
+    private:
+
+    /** @brief Creadora a partir de la corrutina, la usa promise_type::get_return_object. */
+    explicit Tarea(std::coroutine_handle<promise_type> h);
+
+    /** @brief Corrutina de la tarea; nula si se ha movido a otra tarea. */
+    std::coroutine_handle<promise_type> corrutina;
+};
+
+/** @class Simulador_Async
+    @brief Interfaz asincrona del simulador para integrarlo en un servicio. Los comandos se
+    envian como operaciones que se esperan con co_await y que completa un ejecutor por lotes:
+    ejecutar_pendientes aplica en orden los comandos enviados desde la ultima llamada con
+    ejecutar_comando (Ejecutor.hh), como el programa principal, escribiendo la salida de cada
+    uno en un ostringstream, y después reanuda cada corrutina con la salida de su comando. Los
+    <em>at</em> consecutivos se agrupan en un solo Cluster::avanzar_tiempo con la suma de los
+    tiempos, partida como en el Optimizador: si la suma no cabe en Tiempo, antes del
+    <em>at</em> que la desbordaria se aplica la suma acumulada y se empieza otra. Un <em>at</em>
+    con el entero fuera de rango (Comando::entero_valido) no se agrupa. El resultado (salida y
+    estado final) es el mismo que ejecutar los comandos uno a uno. El ejecutor local es el mismo
+    hilo que llama a ejecutar_pendientes, lo que permite probar la interfaz sin hilos; async.cc
+    lo usa como programa principal, de manera que diferencial lo puede comparar con el motor de
+    referencia.
+*/
+class Simulador_Async {
+
+    public:
+
+    /** @class Operacion
+        @brief Comando enviado al simulador pendiente de ejecutar. Al hacer co_await sobre ella,
+        la corrutina se suspende hasta que el ejecutor aplica el comando y el resultado del
+        co_await es la salida que produjo.
+    */
+    class Operacion {
+
+        public:
+
+        /** @brief Operaciones requeridas por co_await: si el comando aun no se ha aplicado,
+         *  la corrutina se suspende y queda registrada como la que lo espera; si ya se ha
+         *  aplicado (la operacion se espera despues de su lote), no se suspende. En los dos
+         *  casos el resultado del co_await es la salida del comando. */
+        bool await_ready() const noexcept;
+        void await_suspend(std::coroutine_handle<> h);
+        std::string await_resume();
+
+
+        private:
+
+        friend class Simulador_Async;
+
+        /** @brief Estado de un comando enviado, compartido por su operacion y los pendientes
+         *  del simulador, de manera que cada operacion sigue siendo valida sea cual sea el
+         *  orden en que se esperan y se ejecutan los lotes. */
+        struct Estado {
+            /** @brief Indica si el ejecutor ya ha aplicado el comando. */
+            bool aplicado;
+            /** @brief Salida del comando, valida si <em>aplicado</em>. */
+            std::string salida;
+            /** @brief Corrutina que espera el comando; nula si no hay ninguna. */
+            std::coroutine_handle<> espera;
+        };
+
+        /** @brief Creadora, solo la usa Simulador_Async::enviar.
+         * \pre <em>estado</em> es el estado de un comando enviado.
+         * \post El resultado es la operacion de ese comando.
+        */
+        explicit Operacion(std::shared_ptr<Estado> estado);
+
+        /** @brief Estado del comando de la operacion. */
+        std::shared_ptr<Estado> estado;
+    };
+
+    //Constructoras
+
+    /** @brief Creadora sobre un cluster y una area de espera.
+     * \pre <em>c</em> y <em>ae</em> existen mientras exista el simulador.
+     * \post El resultado es un simulador sin operaciones pendientes que aplica los comandos a
+     *  <em>c</em> y <em>ae</em>.
+    */
+    Simulador_Async(Cluster &c, Area_de_Espera &ae);
+
+    //Modificadoras
+
+    /** @brief Modificadora que envia un comando.
+     * \pre <em>com</em> no es de tipo FIN ni DESCONOCIDO.
+     * \post El resultado es una operacion que se completa cuando el ejecutor aplica
+     *  <em>com</em>; <em>com</em> se ha añadido al final de los pendientes.
+    */
+    Operacion enviar(Comando &&com);
+
+    /** @brief Modificadora que ejecuta el lote de comandos pendientes.
+     * \pre No la llama ninguna corrutina del propio simulador. Las corrutinas que esperan
+     *  algun comando pendiente no se han destruido.
+     * \post Se han aplicado todos los comandos pendientes, en orden y agrupando los <em>at</em>
+     *  consecutivos, se ha guardado la salida de cada uno en su operacion y se han reanudado
+     *  las corrutinas que los esperaban en orden de envio. Los comandos que envien esas
+     *  corrutinas al reanudarse quedan para el siguiente lote. El resultado es el numero de
+     *  comandos aplicados. Con marcadores (Marcador.hh), la llamada se marca como la fase
+     *  "ejecutar_pendientes" y cada comando aplicado como "ejecutar_comando".
+    */
+    int ejecutar_pendientes();
+
+    //Consultora
+
+    /** @brief Consultora de comandos pendientes.
+     * \pre <em>cierto</em>
+     * \post El resultado es el numero de comandos enviados y aun no aplicados.
+    */
+    int pendientes() const;
+
+
+    private:
+
+    /** @brief Comando pendiente con el estado que comparte con su operacion. */
+    struct Pendiente {
+        Comando com;
+        std::shared_ptr<Operacion::Estado> estado;
+    };
+
+    /** @brief Cluster y area de espera sobre los que se aplican los comandos. */
+    Cluster *c;
+    Area_de_Espera *ae;
+
+    /** @brief Comandos pendientes en orden de envio. */
+    std::vector<Pendiente> cola;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,26 @@
+/** @file Tipos.hh
+    @brief Tipos enteros de memoria y tiempo del simulador.
+
+    La anchura se fija al compilar: por defecto 32 bits, que empaqueta mejor los procesos y
+    permite vectorizar más elementos por instrucción; con <em>-DPRO2_64BITS</em>, 64 bits, para
+    modelar memorias y tiempos que no caben en 32 bits sin desbordar.
+*/
+
+#ifndef TIPOS_HH
+#define TIPOS_HH
+
+#ifndef NO_DIAGRAM
+#include <cstdint>
+#endif
+
+#ifdef PRO2_64BITS
+/** @brief Tamano de memoria (posiciones) de procesos, huecos y procesadores. */
+typedef int64_t Tamano;
+/** @brief Unidades de tiempo de ejecución y de avance del reloj. */
+typedef int64_t Tiempo;
+#else
+typedef int32_t Tamano;
+typedef int32_t Tiempo;
+#endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,106 @@
+/** @file Traza.hh
+    @brief Especificación de la clase Traza.
+*/
+
+#ifndef TRAZA_HH
+#define TRAZA_HH
+
+#ifndef NO_DIAGRAM
+#include <fstream>
+#include <map>
+#include <vector>
+#include <iostream>
+using namespace std;
+#endif
+
+#include "Identificadores.hh"
+
+/** @class Traza
+    @brief Fichero binario con la secuencia de comandos de una sesión del simulador, para
+    grabarla y reproducirla sin volver a analizar el texto de entrada. Los enteros se codifican
+    como varint (7 bits por byte, zigzag para admitir negativos) y los identificadores de
+    procesadores y prioridades se internan: la primera aparición escribe el texto completo y
+    las siguientes solo su indice. Dispone de operaciones para abrir una traza en modo
+    grabación o reproducción y para escribir y leer enteros e identificadores.
+*/
+class Traza {
+
+    public:
+
+    //Constructoras
+
+    /** @brief Creadora por defecto.
+     * \pre <em>cierto</em>
+     * \post El resultado es una traza cerrada.
+    */
+    Traza();
+
+    //Modificadoras
+
+    /** @brief Modificadora que abre una traza para grabarla.
+     * \pre La traza del parametro implicito está cerrada.
+     * \post El resultado indica si se ha podido crear el fichero <em>fichero</em>. Si se ha
+     *  podido, la traza queda abierta en modo grabación, con la tabla de identificadores vacia.
+    */
+    bool abrir_escritura(const string &fichero);
+
+    /** @brief Modificadora que abre una traza para reproducirla.
+     * \pre La traza del parametro implicito está cerrada.
+     * \post El resultado indica si se ha podido abrir el fichero <em>fichero</em> y tiene la
+     *  cabecera de una traza. Si se ha podido, la traza queda abierta en modo reproducción.
+    */
+    bool abrir_lectura(const string &fichero);
+
+    /** @brief Modificadora que cierra la traza.
+     * \pre <em>cierto</em>
+     * \post Se han volcado al fichero los datos pendientes y la traza queda cerrada.
+    */
+    void cerrar();
+
+    /** @brief Operacion de escriptura de un entero.
+     * \pre La traza está abierta en modo grabación.
+     * \post Se ha anadido <em>x</em> a la traza codificado como varint.
+    */
+    void escribir_entero(long long x);
+
+    /** @brief Operacion de escriptura de un identificador.
+     * \pre La traza está abierta en modo grabación.
+     * \post Se ha anadido <em>id</em> a la traza: si es la primera vez que aparece, con su
+     *  texto completo; si no, con el indice que se le asignó.
+    */
+    void escribir_id(Id id);
+
+    /** @brief Operacion de lectura de un entero.
+     * \pre La traza está abierta en modo reproducción y el siguiente dato es un entero.
+     * \post El resultado es el entero leido.
+    */
+    long long leer_entero();
+
+    /** @brief Operacion de lectura de un identificador.
+     * \pre La traza está abierta en modo reproducción y el siguiente dato es un identificador.
+     * \post El resultado es el identificador leido, internado en Identificadores.
+    */
+    Id leer_id();
+
+    //Consultoras
+
+    /** @brief Consultora de fin de traza.
+     * \pre La traza está abierta en modo reproducción.
+     * \post El resultado indica si se han leido todos los datos de la traza.
+    */
+    bool fin() const;
+
+
+    private:
+
+    /** @brief Fichero de la traza. */
+    fstream fichero;
+
+    /** @brief Indice en la traza de cada Id ya escrito (modo grabación). */
+    map<Id,int> indices;
+
+    /** @brief Id de cada indice de la traza ya leido (modo reproducción). */
+    vector<Id> ids;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,93 @@
+/** @file async.cc
+    @brief Programa principal sobre la interfaz de corrutinas (Simulador_Async).
+
+    Lee la misma entrada que program.cc (del canal de entrada, o de un fichero con
+    <em>-f fichero</em>) y produce la misma salida, pero cada comando lo envia una corrutina
+    con co_await y los aplica el ejecutor local por lotes. Sirve para probar la interfaz en el
+    mismo proceso y, con diferencial, para compararla con el motor de referencia.
+
+    Compilado con marcadores (make CONFIG=profile), la variable de entorno PRO2_TRAZA indica
+    el fichero donde se escribe la traza Chrome JSON, como en program.cc.
+*/
+
+#include "Simulador_Async.hh"
+#include "Cluster.hh"
+#include "Area_de_Espera.hh"
+#include "Comando.hh"
+#include "Lector.hh"
+#include "Identificadores.hh"
+#include "Marcador.hh"
+
+#ifndef NO_DIAGRAM
+#include <cstdlib>
+#include <vector>
+#include <string>
+#endif
+
+/** @brief Comandos que se envian antes de llamar al ejecutor. */
+const int LOTE = 64;
+
+/** @brief Corrutina que envia un comando y escribe su salida.
+    \pre <em>com</em> no es de tipo FIN ni DESCONOCIDO.
+    \post La tarea queda suspendida hasta que el ejecutor de <em>sim</em> aplica <em>com</em>;
+    entonces escribe en el canal de salida la salida del comando y termina. Como el ejecutor
+    reanuda las corrutinas en orden de envio, las salidas se escriben en el orden de entrada.
+*/
+Tarea enviar_comando(Simulador_Async &sim, Comando com) {
+    string salida = co_await sim.enviar(std::move(com));
+    cout << salida;
+}
+
+/** @brief Ejecuta los comandos enviados y comprueba que sus corrutinas han terminado.
+    \pre Cada comando pendiente de <em>sim</em> lo espera una tarea de <em>tareas</em>.
+    \post Se han aplicado los comandos pendientes y escrito sus salidas; <em>tareas</em> queda
+    vacia. Si alguna tarea no ha terminado, se ha escrito un error en el canal de error.
+*/
+void ejecutar_lote(Simulador_Async &sim, vector<Tarea> &tareas) {
+    MARCADOR("ejecutar_lote");
+    sim.ejecutar_pendientes();
+    for (const Tarea &t : tareas) {
+        if (not t.terminada()) cerr << "Operacion sin completar despues del lote" << endl;
+    }
+    tareas.clear();
+}
+
+int main(int argc, char *argv[]) {
+
+#ifdef PRO2_MARCADORES
+    const char *fichero_marcadores = getenv("PRO2_TRAZA");
+    if (fichero_marcadores != nullptr and not Marcador::abrir_traza(fichero_marcadores))
+        cerr << "No se puede crear la traza de marcadores " << fichero_marcadores << endl;
+#endif
+
+    Lector entrada;
+    if (argc == 3 and string(argv[1]) == "-f") {
+        if (not entrada.abrir(argv[2])) {
+            cerr << "No se puede abrir la entrada " << argv[2] << endl;
+            return 1;
+        }
+    }
+    else entrada.abrir_entrada_estandar();
+
+    Cluster c1;
+    if (not c1.configurar_cluster(entrada)) {
+        cerr << "Memoria de procesador fuera de rango en la configuración inicial" << endl;
+        return 1;
+    }
+    Area_de_Espera ae;
+    int n = entrada.leer_entero();
+    for (int i = 0; i < n; ++i) ae.alta_prioridad(Identificadores::registrar(entrada.leer_palabra()));
+
+    Simulador_Async sim(c1, ae);
+    vector<Tarea> tareas;
+    Comando com;
+    com.leer(entrada);
+    while (com.consultar_tipo() != Comando::FIN) {
+        if (com.consultar_tipo() != Comando::DESCONOCIDO) {
+            tareas.push_back(enviar_comando(sim, std::move(com)));
+            if (tareas.size() == LOTE) ejecutar_lote(sim, tareas);
+        }
+        com.leer(entrada);
+    }
+    ejecutar_lote(sim, tareas);
+}
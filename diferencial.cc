@@ -0,0 +1,250 @@
+/** @file diferencial.cc
+    @brief Comprobador diferencial del simulador contra el motor de referencia.
+
+    Uso: <em>diferencial motor referencia [sesiones] [comandos] [semilla]</em>, donde
+    <em>motor</em> y <em>referencia</em> son dos ejecutables del programa principal (por
+    ejemplo build/release-32/program.exe y build/referencia-32/program.exe). Genera
+    <em>sesiones</em> sesiones aleatorias (por defecto 200) de <em>comandos</em> comandos (por
+    defecto 300) y las ejecuta con los dos. Las sesiones alternan tres formas de observar el
+    estado con <em>ipc</em>, <em>iae</em> e <em>iec</em>: detrás de cada comando, en puntos
+    aleatorios o solo al final. Las dos ultimas dejan comandos seguidos sin observaciones entre
+    ellos (por ejemplo varios <em>at</em> consecutivos, que el motor puede agrupar) y comparan
+    solo la salida de los comandos y el estado observado, como ocurre con una entrada real.
+    Si una sesión difiere, busca por bisección un prefijo que difiere cuando el prefijo un
+    comando más corto coincide (si se observa tras cada comando, el primer comando que produce
+    la diferencia), lo escribe en diferencial_fallo.txt y termina con código 1.
+*/
+
+#ifndef NO_DIAGRAM
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+using namespace std;
+#endif
+
+/** @brief Configuración inicial y comandos de una sesión, uno por elemento en formato de
+    texto, y si se observa el estado detrás de cada comando. */
+struct Sesion {
+    string configuracion;
+    vector<string> comandos;
+    vector<bool> observar;
+};
+
+/** @brief Formas de observar el estado durante una sesión. */
+enum Observacion {CADA_COMANDO, PUNTOS_ALEATORIOS, SOLO_AL_FINAL};
+
+/** @brief Entero aleatorio en un intervalo.
+    \pre <em>a</em> <= <em>b</em>
+    \post El resultado es un entero uniforme en [<em>a</em>, <em>b</em>].
+*/
+int aleatorio(mt19937 &gen, int a, int b) {
+    return uniform_int_distribution<int>(a, b)(gen);
+}
+
+/** @brief Genera un arbol aleatorio de procesadores.
+    \pre <em>n</em> >= 0
+    \post Se ha anadido a <em>texto</em>, en preorden y con "*" para los arboles vacios, un
+    arbol de <em>n</em> procesadores con identificadores nuevos "p<em>i</em>" a partir de
+    <em>siguiente</em> y memorias aleatorias. Los identificadores se han anadido a
+    <em>procesadores</em>.
+*/
+void generar_arbol(mt19937 &gen, int n, int &siguiente, vector<string> &procesadores,
+                   string &texto) {
+    if (n == 0) {
+        texto += " *";
+        return;
+    }
+    string id = "p" + to_string(siguiente++);
+    procesadores.push_back(id);
+    texto += " " + id + " " + to_string(aleatorio(gen, 10, 200));
+    int izq = aleatorio(gen, 0, n - 1);
+    generar_arbol(gen, izq, siguiente, procesadores, texto);
+    generar_arbol(gen, n - 1 - izq, siguiente, procesadores, texto);
+}
+
+/** @brief Genera una sesión aleatoria.
+    \pre <em>comandos</em> >= 0
+    \post El resultado es una sesión con un cluster y unas prioridades aleatorias y
+    <em>comandos</em> comandos. Los comandos mezclan casos validos y de error (procesadores,
+    prioridades y procesos inexistentes o repetidos) con identificadores de proceso en un
+    rango pequeno para provocar colisiones y empates. El estado se observa detrás de cada
+    comando, detrás de uno de cada diez de media o de ninguno, segun <em>obs</em>.
+*/
+Sesion generar_sesion(mt19937 &gen, int comandos, Observacion obs) {
+
+    Sesion s;
+    int siguiente = 0;
+    vector<string> procesadores;
+    generar_arbol(gen, aleatorio(gen, 1, 12), siguiente, procesadores, s.configuracion);
+    int n = aleatorio(gen, 1, 4);
+    s.configuracion += "\n" + to_string(n);
+    for (int i = 0; i < n; ++i) s.configuracion += " pr" + to_string(i);
+
+    const string modelos[] = { "huecos", "buddy", "bitmap" };
+    for (int i = 0; i < comandos; ++i) {
+        // Un procesador inexistente de vez en cuando para cubrir los errores.
+        string p = aleatorio(gen, 0, 19) == 0 ? "x"
+                   : procesadores[aleatorio(gen, 0, procesadores.size() - 1)];
+        string prioridad = "pr" + to_string(aleatorio(gen, 0, 5));
+        string job = to_string(aleatorio(gen, 0, 49)) + " " + to_string(aleatorio(gen, 1, 120))
+                     + " " + to_string(aleatorio(gen, 1, 20));
+        int tipo = aleatorio(gen, 0, 99);
+        string com;
+        if (tipo < 20) com = "app " + p + " " + job;
+        else if (tipo < 40) com = "ape " + job + " " + prioridad;
+        else if (tipo < 52) com = "epc " + to_string(aleatorio(gen, 0, 6));
+        else if (tipo < 64) com = "at " + to_string(aleatorio(gen, 0, 15));
+        else if (tipo < 70) com = "bpp " + p + " " + to_string(aleatorio(gen, 0, 49));
+        else if (tipo < 75) com = "cmp " + p;
+        else if (tipo < 78) com = "cmc";
+        else if (tipo < 82) com = "bpc " + to_string(aleatorio(gen, 0, 49));
+        else if (tipo < 85) com = "ipro " + p;
+        else if (tipo < 88) com = "ipri " + prioridad;
+        else if (tipo < 91) com = "ap " + prioridad;
+        else if (tipo < 93) com = "bp " + prioridad;
+        else if (tipo < 96) com = "mmp " + p + " " + modelos[aleatorio(gen, 0, 2)];
+        else if (tipo < 97) com = "ifp " + p;
+        else if (tipo < 98) com = "cdp " + p + " " + to_string(aleatorio(gen, 0, 150));
+        else {
+            com = "mc " + p;
+            generar_arbol(gen, aleatorio(gen, 1, 3), siguiente, procesadores, com);
+        }
+        s.comandos.push_back(com);
+        s.observar.push_back(obs == CADA_COMANDO
+                             or (obs == PUNTOS_ALEATORIOS and aleatorio(gen, 0, 9) == 0));
+    }
+    return s;
+}
+
+/** @brief Escribe un prefijo de una sesión como entrada del programa principal.
+    \pre 0 <= <em>k</em> <= numero de comandos de <em>s</em>.
+    \post El resultado indica si se ha podido escribir en <em>fichero</em> la configuración de
+    <em>s</em>, sus <em>k</em> primeros comandos y fin. Van seguidos de ipc, iae e iec la
+    configuración, los comandos que <em>s</em> observa y el ultimo comando escrito.
+*/
+bool escribir_sesion(const Sesion &s, int k, const string &fichero) {
+    ofstream f(fichero);
+    f << s.configuracion << "\nipc\niae\niec\n";
+    for (int i = 0; i < k; ++i) {
+        f << s.comandos[i] << "\n";
+        if (s.observar[i] or i == k - 1) f << "ipc\niae\niec\n";
+    }
+    f << "fin" << endl;
+    return bool(f);
+}
+
+/** @brief Ejecuta el programa principal sobre un fichero de entrada.
+    \pre <em>cierto</em>
+    \post El resultado indica si <em>programa</em> ha terminado con exito leyendo
+    <em>fichero</em> (opción -f); <em>salida</em> es lo que ha escrito en el canal de salida.
+*/
+bool ejecutar(const string &programa, const string &fichero, string &salida) {
+    FILE *canal = popen((programa + " -f " + fichero).c_str(), "r");
+    if (canal == nullptr) return false;
+    salida.clear();
+    char bloque[1 << 16];
+    size_t leidos;
+    while ((leidos = fread(bloque, 1, sizeof(bloque), canal)) > 0) salida.append(bloque, leidos);
+    return pclose(canal) == 0;
+}
+
+/** @brief Compara los dos motores sobre un prefijo de una sesión.
+    \pre 0 <= <em>k</em> <= numero de comandos de <em>s</em>.
+    \post El resultado indica si <em>motor</em> y <em>referencia</em> terminan con exito y
+    escriben lo mismo con los <em>k</em> primeros comandos de <em>s</em>. <em>salida_motor</em>
+    y <em>salida_referencia</em> son las salidas de cada uno.
+*/
+bool coinciden(const string &motor, const string &referencia, const Sesion &s, int k,
+               const string &fichero, string &salida_motor, string &salida_referencia) {
+    if (not escribir_sesion(s, k, fichero)) {
+        cerr << "No se puede escribir la sesión " << fichero << endl;
+        exit(2);
+    }
+    bool ok_motor = ejecutar(motor, fichero, salida_motor);
+    bool ok_referencia = ejecutar(referencia, fichero, salida_referencia);
+    return ok_motor and ok_referencia and salida_motor == salida_referencia;
+}
+
+/** @brief Escribe la primera linea en que difieren dos salidas.
+    \pre <em>cierto</em>
+    \post Se ha escrito en el canal de error el numero de la primera linea distinta de
+    <em>a</em> y <em>b</em> y su contenido en cada una.
+*/
+void escribir_diferencia(const string &a, const string &b) {
+    istringstream ea(a), eb(b);
+    string la, lb;
+    int linea = 1;
+    while (true) {
+        bool hay_a = bool(getline(ea, la));
+        bool hay_b = bool(getline(eb, lb));
+        if (not hay_a) la = "(fin de la salida)";
+        if (not hay_b) lb = "(fin de la salida)";
+        if (la != lb or (not hay_a and not hay_b)) break;
+        ++linea;
+    }
+    cerr << "  linea " << linea << "\n    motor:      " << la << "\n    referencia: " << lb << endl;
+}
+
+int main(int argc, char *argv[]) {
+
+    if (argc < 3) {
+        cerr << "Uso: " << argv[0] << " motor referencia [sesiones] [comandos] [semilla]" << endl;
+        return 2;
+    }
+    string motor = argv[1], referencia = argv[2];
+    int sesiones = argc >= 4 ? atoi(argv[3]) : 200;
+    int comandos = argc >= 5 ? atoi(argv[4]) : 300;
+    unsigned semilla = argc >= 6 ? strtoul(argv[5], nullptr, 10) : random_device()();
+
+    char plantilla[] = "/tmp/diferencialXXXXXX";
+    int fd = mkstemp(plantilla);
+    if (fd < 0) {
+        cerr << "No se puede crear el fichero temporal" << endl;
+        return 2;
+    }
+    close(fd);
+    string fichero = plantilla;
+
+    cout << "semilla " << semilla << endl;
+    mt19937 gen(semilla);
+    string salida_motor, salida_referencia;
+    for (int i = 0; i < sesiones; ++i) {
+        Sesion s = generar_sesion(gen, comandos, Observacion(i % 3));
+        int n = s.comandos.size();
+        if (coinciden(motor, referencia, s, n, fichero, salida_motor, salida_referencia)) {
+            continue;
+        }
+
+        // Invariante: el prefijo de fin comandos difiere y, si ini > 0, el de ini - 1
+        // coincide. Si se observa tras cada comando, un prefijo que difiere hace diferir a
+        // todos los más largos y ini es el primer comando que produce la diferencia; con menos
+        // observaciones una diferencia puede quedar oculta y ini es solo un comando que la hace
+        // visible al observar justo detrás.
+        int ini = 0, fin = n;
+        while (ini < fin) {
+            int k = (ini + fin) / 2;
+            if (coinciden(motor, referencia, s, k, fichero, salida_motor, salida_referencia)) {
+                ini = k + 1;
+            }
+            else fin = k;
+        }
+        coinciden(motor, referencia, s, ini, fichero, salida_motor, salida_referencia);
+        escribir_sesion(s, ini, "diferencial_fallo.txt");
+        remove(fichero.c_str());
+
+        cerr << "Sesión " << i << ": los motores difieren";
+        if (ini == 0) cerr << " con la configuración inicial" << endl;
+        else cerr << " en el comando " << ini << ": " << s.comandos[ini - 1] << endl;
+        escribir_diferencia(salida_motor, salida_referencia);
+        cerr << "Sesión reducida en diferencial_fallo.txt" << endl;
+        return 1;
+    }
+    remove(fichero.c_str());
+    cout << sesiones << " sesiones de " << comandos << " comandos sin diferencias" << endl;
+}
@@ -0,0 +1,203 @@
+/** @file microbench.cc
+    @brief Microbenchmarks de las operaciones básicas de los modulos.
+
+    Uso: <em>microbench</em> escribe las medidas; <em>microbench -g fichero</em> además las
+    guarda como base; <em>microbench -c fichero [umbral]</em> las compara con una base y
+    termina con código 1 si alguna empeora más del umbral (por defecto 0.10). Si la base no
+    existe, <em>-c</em> solo la crea con las medidas actuales.
+*/
+
+#include "Banco_Pruebas.hh"
+#include "Procesador.hh"
+#include "Cluster.hh"
+#include "Prioridad.hh"
+#include "Proceso.hh"
+#include "Lector.hh"
+#include "Identificadores.hh"
+
+#ifndef NO_DIAGRAM
+#include <cstdlib>
+#include <new>
+#endif
+
+void *operator new(size_t n) {
+    Banco_Pruebas::anotar_reserva();
+    void *p = malloc(n == 0 ? 1 : n);
+    if (p == nullptr) throw bad_alloc();
+    return p;
+}
+
+void operator delete(void *p) noexcept {
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+    free(p);
+}
+
+// Las reservas alineadas (bloques alignas(64) de Prioridad, colas) usan estas versiones.
+void *operator new(size_t n, align_val_t alineacion) {
+    Banco_Pruebas::anotar_reserva();
+    size_t a = static_cast<size_t>(alineacion);
+    void *p = aligned_alloc(a, n == 0 ? a : (n + a - 1) / a * a);
+    if (p == nullptr) throw bad_alloc();
+    return p;
+}
+
+void operator delete(void *p, align_val_t) noexcept {
+    free(p);
+}
+
+void operator delete(void *p, size_t, align_val_t) noexcept {
+    free(p);
+}
+
+/** @brief Configura un procesador con una memoria.
+    \pre <em>memoria</em> > 0
+    \post <em>p</em> es un procesador nuevo, vacio y con el modelo por defecto, identificado
+    como <em>id</em> con <em>memoria</em> posiciones.
+*/
+void configurar(Procesador &p, const string &id, Tamano memoria) {
+    p = Procesador();
+    string texto = id + " " + to_string(memoria);
+    Lector entrada;
+    entrada.abrir_texto(texto);
+    p.configurar_procesador(entrada);
+}
+
+/** @brief Genera la configuración de un arbol de procesadores.
+    \pre <em>forma</em> es "lineal" o "equilibrado"; <em>n</em> >= 0.
+    \post Se ha anadido a <em>texto</em>, en preorden y con "*" para los arboles vacios, un
+    arbol de <em>n</em> procesadores de <em>memoria</em> posiciones: una cadena de auxiliares
+    izquierdos (lineal) o un arbol con el mismo numero de nodos en cada lado (equilibrado).
+*/
+void generar_arbol(const string &forma, int n, Tamano memoria, int &siguiente, string &texto) {
+    if (n == 0) {
+        texto += " *";
+        return;
+    }
+    texto += " c" + to_string(siguiente++) + " " + to_string(memoria);
+    if (forma == "lineal") {
+        generar_arbol(forma, n - 1, memoria, siguiente, texto);
+        generar_arbol(forma, 0, memoria, siguiente, texto);
+    }
+    else {
+        generar_arbol(forma, (n - 1) / 2, memoria, siguiente, texto);
+        generar_arbol(forma, n - 1 - (n - 1) / 2, memoria, siguiente, texto);
+    }
+}
+
+int main(int argc, char *argv[]) {
+
+    const int JOBS = 1000;
+    Banco_Pruebas banco(15);
+
+    // Altas de tamanos variados y bajas en otro orden con cada modelo de memoria, en una
+    // memoria pequena y en una de millones de posiciones. Los tamanos van hasta
+    // memoria / (4 JOBS), así que incluso redondeados a potencias de dos (buddy) los JOBS
+    // procesos ocupan como mucho la mitad de la memoria: todas las altas se hacen, las bajas
+    // son de procesos colocados y los tres modelos hacen el mismo trabajo.
+    const string modelos[] = { "huecos", "buddy", "bitmap" };
+    const int bits_memoria[] = { 16, 24 };
+    for (const string &modelo : modelos) {
+        for (int bits : bits_memoria) {
+            Procesador p;
+            Tamano tope = (Tamano(1) << bits) / (4 * JOBS);
+            banco.medir("procesador_alta_baja_" + modelo + "_" + to_string(bits),
+                [&p, &modelo, bits]() {
+                    configurar(p, "p", Tamano(1) << bits);
+                    p.modificar_modelo_memoria(modelo);
+                },
+                [&p, tope]() {
+                    for (int i = 0; i < JOBS; ++i) {
+                        p.alta_proceso_procesador(Proceso(i, 1 + (i * 37) % tope, 10));
+                    }
+                    for (int i = 0; i < JOBS; ++i) p.baja_proceso_procesador((i * 7) % JOBS);
+                }, 2 * JOBS);
+        }
+    }
+
+    // Fin simultaneo de muchos procesos en un mismo avance de tiempo (liberación masiva).
+    // Cada medida tiene su propio procesador, y configurar lo deja nuevo en cada repetición.
+    {
+        Procesador p;
+        banco.medir("procesador_fin_masivo",
+            [&p]() {
+                configurar(p, "p", 1 << 20);
+                for (int i = 0; i < JOBS; ++i) {
+                    p.alta_proceso_procesador(Proceso(i, 1 + (i * 37) % 500, 1 + i % 2));
+                }
+            },
+            [&p]() { p.avanzar_tiempo_procesador(2); }, JOBS);
+    }
+
+    // Colocación en el cluster segun la forma del arbol.
+    const string formas[] = { "lineal", "equilibrado" };
+    for (const string &forma : formas) {
+        Cluster c;
+        banco.medir("cluster_alta_proceso_" + forma,
+            [&c, &forma]() {
+                string texto;
+                int siguiente = 0;
+                generar_arbol(forma, 63, 1 << 16, siguiente, texto);
+                Lector entrada;
+                entrada.abrir_texto(texto);
+                c.configurar_cluster(entrada);
+            },
+            [&c]() {
+                for (int i = 0; i < JOBS; ++i) {
+                    c.alta_proceso(Proceso(i, 1 + (i * 37) % 500, 10));
+                }
+            }, JOBS);
+    }
+
+    // Cola de una prioridad: encolar y extraer el más antiguo.
+    Prioridad pr(Identificadores::registrar("bench"));
+    banco.medir("prioridad_encolar_extraer",
+        []() { },
+        [&pr]() {
+            for (int i = 0; i < 10 * JOBS; ++i) {
+                pr.alta_proceso_prioridad(Proceso(i, 1 + i % 500, 10));
+            }
+            for (int i = 0; i < 10 * JOBS; ++i) pr.extraer_mas_antiguo();
+        }, 20 * JOBS);
+
+    // Compactación con distintos porcentajes de memoria liberada.
+    const int porcentajes[] = { 10, 50, 90 };
+    for (int porcentaje : porcentajes) {
+        Procesador p;
+        banco.medir("compactar_" + to_string(porcentaje),
+            [&p, porcentaje]() {
+                configurar(p, "p", 10 * JOBS);
+                for (int i = 0; i < JOBS; ++i) p.alta_proceso_procesador(Proceso(i, 10, 10));
+                for (int i = 0; i < JOBS; ++i) {
+                    if (i % 100 < porcentaje) p.baja_proceso_procesador(i);
+                }
+            },
+            [&p]() { p.compactar_memoria_procesador(); }, 1);
+    }
+
+    // Compactación deslizante hasta un hueco de 100 procesos con la mitad liberada.
+    {
+        Procesador p;
+        banco.medir("compactar_deslizando_50",
+            [&p]() {
+                configurar(p, "p", 10 * JOBS);
+                for (int i = 0; i < JOBS; ++i) p.alta_proceso_procesador(Proceso(i, 10, 10));
+                for (int i = 0; i < JOBS; i += 2) p.baja_proceso_procesador(i);
+            },
+            [&p]() { p.compactar_deslizando(1000); }, 1);
+    }
+
+    banco.imprimir();
+
+    string modo = argc >= 3 ? string(argv[1]) : "";
+    if (modo == "-g" and not banco.guardar(argv[2])) {
+        cerr << "No se puede escribir la base " << argv[2] << endl;
+        return 1;
+    }
+    if (modo == "-c") {
+        double umbral = argc >= 4 ? atof(argv[3]) : 0.10;
+        if (not banco.comparar(argv[2], umbral)) return 1;
+    }
+}
\ No newline at end of file
@@ -15,151 +15,290 @@
     Suponemos que los datos leídos son siempre correctos, ya que no
     incluimos combrobaciones al respecto.  Para acceder a las opciones
     disponibles usaremos comandos.
+
+    Con la opción <em>-g fichero</em> se graba además la sesión en una traza binaria;
+    con <em>-r fichero</em> se reproduce una traza grabada sin leer el canal de entrada,
+    produciendo la misma salida y el mismo estado final.
+
+    Con la opción <em>-p N</em> el simulador se reparte en N clusters independientes, cada
+    uno en su propio hilo (ver Despachador). La configuración inicial tiene entonces N
+    clusters y el comando <em>cc</em> no está disponible.
+
+    Con la opción <em>-t</em> la lectura, la ejecución y la escritura de los comandos se
+    hacen en tres hilos conectados por colas acotadas; la salida es identica byte a byte.
+
+    En el modo normal los comandos pasan por un Optimizador antes de ejecutarse, excepto en
+    el motor de referencia (make CONFIG=referencia), que ejecuta cada comando tal como se lee.
+
+    Con la opción <em>-e fichero...</em>, además de la entrada estandar, un hilo productor por
+    fichero envia a la area de espera los procesos del fichero (ver producir) mientras se
+    ejecutan los comandos; entran en sus prioridades antes del siguiente comando que usa la
+    area de espera. Los comandos <em>ap</em> y <em>bp</em> esperan a que terminen los productores.
+
+    Con la opción <em>-f fichero</em> la entrada se lee del fichero indicado en lugar de la
+    entrada estandar. En los modos normal, <em>-g</em> y <em>-t</em> la entrada se lee con un
+    Lector, que proyecta en memoria la entrada cuando es un fichero regular.
+
+    Compilado con marcadores (make CONFIG=profile), la variable de entorno PRO2_TRAZA indica
+    el fichero donde se escribe la traza Chrome JSON de las fases del simulador.
 */
 
 #include "Cluster.hh"
 #include "Proceso.hh"
 #include "Area_de_Espera.hh"
+#include "Comando.hh"
+#include "Traza.hh"
+#include "Identificadores.hh"
+#include "Despachador.hh"
+#include "Cola_SPSC.hh"
+#include "Optimizador.hh"
+#include "Lector.hh"
+#include "Marcador.hh"
+#include "Ejecutor.hh"
 
-int main () {
-
-    Cluster c1;
-    c1.configurar_cluster();
+#ifndef NO_DIAGRAM
+#include <cstdlib>
+#include <sstream>
+#include <thread>
+#include <atomic>
+#endif
 
-    Area_de_Espera ae;
-    int n;
-    cin >> n;
-    for (int i = 0; i < n; ++i) {
-        string id_prioridad;
-        cin >> id_prioridad;
-        ae.alta_prioridad(id_prioridad);
+/** @brief Envia los procesos de un fichero a la area de espera desde otro hilo.
+    \pre <em>fichero</em> contiene procesos (identificador, memoria y tiempo) seguidos cada
+    uno del identificador de una prioridad. Mientras se ejecuta no se da de alta ni de baja
+    ninguna prioridad de <em>ae</em>.
+    \post Se han anadido en orden los procesos de <em>fichero</em> a la entrada concurrente de
+    su prioridad (Area_de_Espera::alta_proceso_concurrente), esperando mientras estaba llena.
+    Los procesos de una prioridad inexistente o con algun entero fuera de rango
+    (Proceso::leer) se han descartado escribiendo un error en el canal de error. Se pueden ejecutar varios productores a la vez.
+*/
+void producir(const string &fichero, Area_de_Espera &ae) {
+    Lector entrada;
+    if (not entrada.abrir(fichero)) {
+        cerr << "No se puede abrir el fichero de procesos " << fichero << endl;
+        return;
     }
-
-    string command;
-    cin >> command;
-    while (command != "fin") {
-
-        if (command == "cc") {
-            c1.configurar_cluster();
+    while (not entrada.fin()) {
+        Proceso job;
+        bool valido = job.leer(entrada);
+        Id id_prioridad = Identificadores::registrar(entrada.leer_palabra());
+        if (not valido) {
+            cerr << "Productor " << fichero << ": entero fuera de rango" << endl;
         }
-        else if (command == "mc"){
-            string id_procesador;
-            cin >> id_procesador;
-
-            Cluster c2;
-            c2.configurar_cluster();
-
-            if (not c1.existe_procesador(id_procesador)) 
-            cout << "ERROR: El procesador no existe" << endl;
-            else if(not c1.vacio(id_procesador)) 
-            cout << "ERROR: El procesador tiene procesadores auxiliares dependientes" << endl;
-            else if (c1.procesador_ocupado(id_procesador))
-            cout << "ERROR: El procesador tiene procesos en ejecucion" << endl;
-            else c1.modificar_cluster(id_procesador,c2);
+        else if (not ae.existe_prioridad(id_prioridad)) {
+            cerr << "Productor " << fichero << ": la prioridad "
+                 << Identificadores::nombre(id_prioridad) << " no existe" << endl;
         }
-        else if (command == "ap"){
-            string id_prioridad;
-            cin >> id_prioridad;
-
-            if (ae.existe_prioridad(id_prioridad)) 
-            cout << "ERROR: La prioridad ya existe" << endl;
-            else ae.alta_prioridad(id_prioridad);
-        }
-        else if (command == "bp"){
-            string id_prioridad;
-            cin >> id_prioridad;
-
-            if (not ae.existe_prioridad(id_prioridad)) 
-            cout << "ERROR: La prioridad no existe" << endl;
-            else if (ae.ocupado(id_prioridad)) 
-            cout << "ERROR: La prioridad tiene procesos pendientes" << endl;
-            else ae.baja_prioridad(id_prioridad);
-        }
-        else if (command == "ape"){
-            Proceso job;
-            job.leer();
-
-            string id_prioridad;
-            cin >> id_prioridad;
-
-            if (not ae.existe_prioridad(id_prioridad)) 
-            cout << "ERROR: La prioridad no existe" << endl;
-            else if (ae.existe_proceso(id_prioridad, job.consultar_id())) 
-            cout << "ERROR: El proceso ya existe en la prioridad" << endl;
-            else ae.alta_proceso_espera(id_prioridad, job);
-        }
-        else if (command == "app"){
-            string id_procesador;
-            cin >> id_procesador;
-
-            Proceso job;
-            job.leer();
-
-            if (not c1.existe_procesador(id_procesador)) 
-            cout << "ERROR: El procesador no existe" << endl;
-            else if(c1.existe_proceso(id_procesador,job.consultar_id())) 
-            cout << "ERROR: El proceso ya existe en el procesador" << endl;
-            else if (c1.espacio_procesador(id_procesador) < job.consultar_tamano()) 
-            cout << "ERROR: No hay suficiente espacio en la memoria" << endl;
-            else c1.alta_proceso_procesador(id_procesador, job);
+        else {
+            MARCADOR("producir");
+            while (not ae.alta_proceso_concurrente(id_prioridad, std::move(job))) {
+                this_thread::yield();
+            }
         }
-        else if (command == "bpp"){
-            string id_procesador;
-            cin >> id_procesador;
-
-            int id_job;
-            cin >> id_job;
-
-            if (not c1.existe_procesador(id_procesador)) 
-            cout << "ERROR: El procesador no existe" << endl;
-            else if(not c1.existe_proceso(id_procesador,id_job)) 
-            cout << "ERROR: El proceso no existe en el procesador" << endl;
-            else c1.baja_proceso_procesador(id_procesador, id_job);
-        }
-        else if (command == "epc"){
-            int n;
-            cin >> n;
-            ae.enviar_procesos_cluster(n,c1);
-        }
-        else if (command == "at"){
-            int t;
-            cin >> t;
+    }
+}
 
-            c1.avanzar_tiempo(t);
-        }
-        else if (command == "ipri"){
-            string id_prioridad;
-            cin >> id_prioridad;
-            if (not ae.existe_prioridad(id_prioridad)) 
-            cout << "ERROR: La prioridad no existe" << endl;
-            else ae.imprimir_prioridad(id_prioridad);
+/** @brief Ejecuta los comandos de la sesión en tres etapas concurrentes.
+    \pre Hay en <em>entrada</em> comandos hasta <em>fin</em>.
+    \post Se han ejecutado todos los comandos sobre <em>c1</em> y <em>ae</em>. Un hilo lector
+    analiza los comandos por adelantado, el hilo actual los ejecuta capturando la salida de
+    cada uno y un hilo escritor la escribe en el canal de salida en el mismo orden.
+*/
+void ejecutar_segmentado(Lector &entrada, Cluster &c1, Area_de_Espera &ae) {
+
+    Cola_SPSC<Comando> comandos(1024);
+    Cola_SPSC<string> salidas(1024);
+    atomic<bool> ejecucion_terminada(false);
+
+    streambuf *canal_salida = cout.rdbuf();
+
+    thread lector([&comandos, &entrada]() {
+        Comando::Tipo tipo;
+        do {
+            Comando com;
+            com.leer(entrada);
+            tipo = com.consultar_tipo();
+            if (tipo != Comando::DESCONOCIDO) {
+                while (not comandos.encolar(std::move(com))) this_thread::yield();
+            }
+        } while (tipo != Comando::FIN);
+    });
+
+    thread escritor([&salidas, &ejecucion_terminada, canal_salida]() {
+        ostream canal(canal_salida);
+        string s;
+        bool terminado = false;
+        while (not terminado) {
+            if (salidas.desencolar(s)) canal << s;
+            else if (ejecucion_terminada) {
+                while (salidas.desencolar(s)) canal << s;
+                terminado = true;
+            }
+            else this_thread::yield();
         }
-        else if (command == "iae"){
-            ae.imprimir_area_espera();
+        canal.flush();
+    });
+
+    ostringstream buffer;
+    Comando com;
+    while (not comandos.desencolar(com)) this_thread::yield();
+    while (com.consultar_tipo() != Comando::FIN) {
+        ejecutar_comando(com, c1, ae, buffer);
+        string s = buffer.str();
+        if (not s.empty()) {
+            while (not salidas.encolar(std::move(s))) this_thread::yield();
+            buffer.str("");
         }
-        else if (command == "ipro"){
-            string id_procesador;
-            cin >> id_procesador;
-            if (not c1.existe_procesador(id_procesador)) 
-            cout << "ERROR: El procesador no existe" << endl;
-            else c1.imprimir_procesador(id_procesador);
+        while (not comandos.desencolar(com)) this_thread::yield();
+    }
+    ejecucion_terminada = true;
+
+    lector.join();
+    escritor.join();
+}
+
+/** @brief Ejecuta la sesión en modo particionado.
+    \pre <em>n</em> > 0. Hay en el canal de entrada la configuración inicial de <em>n</em>
+    clusters y las prioridades, seguida de comandos hasta <em>fin</em>.
+    \post El resultado indica si la configuración inicial es valida (Despachador::configurar).
+    Si lo es, se han ejecutado todos los comandos sobre un Despachador de <em>n</em>
+    particiones; si no, se ha escrito un error en el canal de error.
+*/
+bool ejecutar_particionado(int n) {
+
+    Despachador d(n);
+    if (not d.configurar()) {
+        cerr << "Memoria de procesador fuera de rango en la configuración inicial" << endl;
+        return false;
+    }
+
+    Comando com;
+    com.leer();
+    while (com.consultar_tipo() != Comando::FIN) {
+        if (com.consultar_tipo() == Comando::CC)
+        cout << "ERROR: Comando no disponible en modo particionado" << endl;
+        else if (com.consultar_tipo() != Comando::DESCONOCIDO) {
+            MARCADOR("despachar");
+            d.ejecutar(com);
         }
-        else if (command == "ipc"){
-            c1.imprimir_procesador_cluster();
+        com.leer();
+    }
+    return true;
+}
+
+int main (int argc, char *argv[]) {
+
+#ifdef PRO2_MARCADORES
+    const char *fichero_marcadores = getenv("PRO2_TRAZA");
+    if (fichero_marcadores != nullptr and not Marcador::abrir_traza(fichero_marcadores))
+        cerr << "No se puede crear la traza de marcadores " << fichero_marcadores << endl;
+#endif
+
+    string modo = argc >= 2 ? string(argv[1]) : "";
+    bool segmentado = modo == "-t" and argc == 2;
+    bool con_productores = modo == "-e" and argc >= 3;
+    if (argc != 3) modo = "";
+    if (modo == "-p") {
+        int n = atoi(argv[2]);
+        if (n <= 0) {
+            cerr << "Numero de particiones incorrecto: " << argv[2] << endl;
+            return 1;
         }
-        else if (command == "iec"){
-            c1.imprimir_estructura_cluster();
+        return ejecutar_particionado(n) ? 0 : 1;
+    }
+    bool grabar = modo == "-g";
+    bool reproducir = modo == "-r";
+
+    Lector entrada;
+    if (modo == "-f") {
+        if (not entrada.abrir(argv[2])) {
+            cerr << "No se puede abrir la entrada " << argv[2] << endl;
+            return 1;
         }
-        else if (command == "cmp"){
-            string id_procesador;
-            cin >> id_procesador;
-            if (not c1.existe_procesador(id_procesador)) 
-            cout << "ERROR: El procesador no existe" << endl;
-            c1.compactar_memoria_procesador(id_procesador);
+    }
+    else if (not reproducir) entrada.abrir_entrada_estandar();
+
+    Traza traza;
+    if (grabar and not traza.abrir_escritura(argv[2])) {
+        cerr << "No se puede crear la traza " << argv[2] << endl;
+        return 1;
+    }
+    if (reproducir and not traza.abrir_lectura(argv[2])) {
+        cerr << "No se puede abrir la traza " << argv[2] << endl;
+        return 1;
+    }
+
+    Cluster c1;
+    if (reproducir) c1.configurar_cluster(traza);
+    else if (not c1.configurar_cluster(entrada)) {
+        cerr << "Memoria de procesador fuera de rango en la configuración inicial" << endl;
+        return 1;
+    }
+    if (grabar) c1.escribir_configuracion(traza);
+
+    Area_de_Espera ae;
+    int n;
+    if (reproducir) n = traza.leer_entero();
+    else n = entrada.leer_entero();
+    if (grabar) traza.escribir_entero(n);
+    for (int i = 0; i < n; ++i) {
+        Id id_prioridad;
+        if (reproducir) id_prioridad = traza.leer_id();
+        else id_prioridad = Identificadores::registrar(entrada.leer_palabra());
+        if (grabar) traza.escribir_id(id_prioridad);
+        ae.alta_prioridad(id_prioridad);
+    }
+
+    vector<thread> productores;
+    if (con_productores) {
+        for (int i = 2; i < argc; ++i) {
+            string fichero = argv[i];
+            productores.emplace_back([fichero, &ae]() { producir(fichero, ae); });
         }
-        else if (command == "cmc"){
-            c1.compactar_memoria_cluster();
+    }
+    auto esperar_productores = [&productores]() {
+        for (thread &t : productores) t.join();
+        productores.clear();
+    };
+
+    if (segmentado) {
+        ejecutar_segmentado(entrada, c1, ae);
+        return 0;
+    }
+
+#ifndef PRO2_REFERENCIA
+    Optimizador opt(c1, ae);
+#endif
+    Comando com;
+    if (reproducir) com.leer(traza);
+    else com.leer(entrada);
+    while (com.consultar_tipo() != Comando::FIN) {
+        if (com.consultar_tipo() != Comando::DESCONOCIDO) {
+            if (grabar) com.escribir(traza);
+            if (com.consultar_tipo() == Comando::AP or com.consultar_tipo() == Comando::BP) {
+                esperar_productores();
+            }
+#ifdef PRO2_REFERENCIA
+            ejecutar_comando(com, c1, ae, cout);
+#else
+            opt.anadir(std::move(com));
+            while (opt.hay_listo()) {
+                Comando sig;
+                if (opt.siguiente(sig)) ejecutar_comando(sig, c1, ae, cout);
+            }
+#endif
         }
-        cin >> command;
+        if (reproducir) com.leer(traza);
+        else com.leer(entrada);
+    }
+#ifndef PRO2_REFERENCIA
+    opt.vaciar();
+    while (opt.hay_listo()) {
+        Comando sig;
+        if (opt.siguiente(sig)) ejecutar_comando(sig, c1, ae, cout);
     }
+#endif
+    esperar_productores();
+    if (grabar) com.escribir(traza);
+    traza.cerrar();
 }
\ No newline at end of file